@@ -234,6 +234,9 @@ kymera_chain_handle_t appKymeraScoCreateChain(const appKymeraScoChainInfo *info)
 
     theKymera->sco_info = info;
 
+    /* Free the DSP memory held by an idle tone/prompt chain first */
+    appKymeraTonePromptCacheRelease();
+
     /* Create chain and return handle */
     theKymera->chainu.sco_handle = ChainCreate(info->chain);
 
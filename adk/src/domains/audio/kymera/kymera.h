@@ -101,6 +101,16 @@ typedef struct
     kymera_chain_handle_t chain_input_handle;
     /*! The tone chain is used when a tone is played. */
     kymera_chain_handle_t chain_tone_handle;
+    /*! A stopped tone/prompt chain kept for the next tone or prompt. */
+    kymera_chain_handle_t chain_tone_cache_handle;
+    /*! The configuration the playing or cached tone/prompt chain was
+        created from. */
+    const chain_config_t *tone_cache_config;
+    /*! The tone/prompt sample rate the playing or cached chain was
+        configured for. */
+    uint32 tone_cache_rate;
+    /*! The output sample rate the cached chain was configured for. */
+    uint32 tone_cache_output_rate;
 
     /*! The output_vol_handle/sco_handle chain are used mutually exclusively.
         The output_vol_handle/sco_handle both contain OPR_SOURCE_SYNC/OPR_VOLUME_CONTROL.
@@ -142,6 +152,9 @@ typedef struct
     /*! Number of tones/prompts playing and queued up to be played */
     uint8 tone_count;
 
+    /*! Time taken to set up and start the last tone/prompt, in milliseconds */
+    uint16 tone_setup_time_ms;
+
     /*! Which microphone to use during mic forwarding */
     micSelection mic;
     const appKymeraScoChainInfo *sco_info;
@@ -376,6 +376,9 @@ void appKymeraA2dpStartForwarding(const a2dp_codec_settings *codec_settings)
     DEBUG_LOGF("appKymeraA2dpStartForwarding, media_source %p, audio_source %p, seid %d, state %u",
                 media_source, audio_source, seid, appKymeraGetState());
 
+    /* Forwarding needs more of the DSP, don't keep an idle tone/prompt chain */
+    appKymeraTonePromptCacheRelease();
+
     switch (seid)
     {
         case AV_SEID_APTX_MONO_TWS_SRC:
@@ -132,6 +132,7 @@ static void kymera_CreateAecChain(void)
 {
     DEBUG_LOG("kymera_CreateAecChain");
     PanicNotNull(kymera_GetAecChain());
+    appKymeraTonePromptCacheRelease();
     kymera_SetAecChain(PanicNull(ChainCreate(&chain_aec_config)));
     kymera_ConfigureAecChain();
     ChainConnect(kymera_GetAecChain());
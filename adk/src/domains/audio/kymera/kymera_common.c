@@ -177,6 +177,12 @@ void appKymeraSetState(appKymeraState state)
     DEBUG_LOGF("appKymeraSetState, state %u -> %u", theKymera->state, state);
     theKymera->state = state;
 
+    /* The DSP may be powered off once idle, don't keep operators alive */
+    if (state == KYMERA_STATE_IDLE)
+    {
+        appKymeraTonePromptCacheRelease();
+    }
+
     /* Set busy lock if not in idle or tone state */
     theKymera->busy_lock = (state != KYMERA_STATE_IDLE) && (state != KYMERA_STATE_TONE_PLAYING);
 }
@@ -103,6 +103,12 @@
     range appConfigVoiceQualityWorst() to appConfigVoiceQualityBest(). */
 #define appConfigVoiceQualityWhenDisabled() appConfigVoiceQualityBest()
 
+/*! Set to TRUE to keep the tone/prompt chain built but idle after a tone or
+    prompt has finished, so the next one with the same format and rate can be
+    started without creating a new chain. The chain is only kept while another
+    audio chain is keeping the DSP active. */
+#define appConfigKymeraTonePromptCacheEnabled() (TRUE)
+
 /*! Minimum volume gain in dB */
 #define appConfigMinVolumedB() (-45)
 
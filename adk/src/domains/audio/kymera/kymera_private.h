@@ -318,6 +318,12 @@ const appKymeraScoChainInfo *appKymeraScoFindChain(const appKymeraScoChainInfo *
 /*! \brief Immediately stop playing the tone or prompt */
 void appKymeraTonePromptStop(void);
 
+/*! \brief Destroy the cached tone/prompt chain, if there is one.
+
+    Call before creating chains or starting forwarding, so an idle tone/prompt
+    chain doesn't hold DSP memory they need. */
+void appKymeraTonePromptCacheRelease(void);
+
 /*! \brief Create and configure the audio output chain.
     \param kick_period The kymera kick period.
     \param buffer_size The PCM buffer size.
@@ -108,6 +108,9 @@ void appKymeraHandleInternalScoForwardingStartTx(Sink forwarding_sink)
 
     PanicNotZero(theKymera->lock);
 
+    /* Forwarding needs more of the DSP, don't keep an idle tone/prompt chain */
+    appKymeraTonePromptCacheRelease();
+
     /* Tell SCO forwarding what the source of SCO frames is and enable the
      * passthrough to give it the SCO frames. */
     ScoFwdInitScoPacketising(scofwd_ep_src);
@@ -10,6 +10,8 @@
 #include "kymera_private.h"
 #include "kymera_config.h"
 
+#include <vm.h>
+
 #include "chains/chain_tone_gen.h"
 #include "chains/chain_tone_gen_no_iir.h"
 #include "chains/chain_prompt_decoder.h"
@@ -38,6 +40,61 @@ static void appKymeraPromptSourceClose(Source source)
     }
 }
 
+/*! \brief Take the cached tone/prompt chain if it was built for the same
+           configuration and sample rates.
+    \param config The chain configuration required.
+    \param rate The tone/prompt sample rate.
+    \return The cached chain, or NULL if there's no matching chain.
+*/
+static kymera_chain_handle_t appKymeraTonePromptCacheTake(const chain_config_t *config, uint32 rate)
+{
+    kymeraTaskData *theKymera = KymeraGetTaskData();
+    kymera_chain_handle_t chain = theKymera->chain_tone_cache_handle;
+
+    if (chain)
+    {
+        if (theKymera->tone_cache_config == config &&
+            theKymera->tone_cache_rate == rate &&
+            theKymera->tone_cache_output_rate == theKymera->output_rate)
+        {
+            theKymera->chain_tone_cache_handle = NULL;
+            return chain;
+        }
+        /* Doesn't match, don't keep two chains in DSP memory */
+        appKymeraTonePromptCacheRelease();
+    }
+    return NULL;
+}
+
+/*! \brief Keep a stopped tone/prompt chain for reuse.
+    \param chain The stopped chain, its output must already be disconnected.
+    \param config The configuration the chain was created from.
+    \param rate The tone/prompt sample rate the chain was configured for.
+*/
+static void appKymeraTonePromptCachePut(kymera_chain_handle_t chain, const chain_config_t *config, uint32 rate)
+{
+    kymeraTaskData *theKymera = KymeraGetTaskData();
+
+    appKymeraTonePromptCacheRelease();
+    theKymera->chain_tone_cache_handle = chain;
+    theKymera->tone_cache_config = config;
+    theKymera->tone_cache_rate = rate;
+    theKymera->tone_cache_output_rate = theKymera->output_rate;
+}
+
+void appKymeraTonePromptCacheRelease(void)
+{
+    kymeraTaskData *theKymera = KymeraGetTaskData();
+
+    if (theKymera->chain_tone_cache_handle)
+    {
+        DEBUG_LOG("appKymeraTonePromptCacheRelease");
+        ChainDestroy(theKymera->chain_tone_cache_handle);
+        theKymera->chain_tone_cache_handle = NULL;
+        theKymera->tone_cache_config = NULL;
+    }
+}
+
 /*! \brief Create the tone / prompt audio chain.
     \param msg Message containing the create parameters.
 */
@@ -73,7 +130,20 @@ static Source appKymeraCreateTonePromptChain(const KYMERA_INTERNAL_TONE_PROMPT_P
     if (config)
     {
         Operator op;
-        chain = ChainCreate(config);
+        kymera_chain_handle_t cached_chain = appKymeraTonePromptCacheTake(config, msg->rate);
+
+        if (cached_chain)
+        {
+            DEBUG_LOG("appKymeraCreateTonePromptChain, reusing cached chain");
+            chain = cached_chain;
+        }
+        else
+        {
+            chain = ChainCreate(config);
+        }
+
+        /* A cached chain was reset when it was stopped, so is configured
+           again the same as a new one */
         if (has_resampler)
         {
             /* Configure resampler */
@@ -88,8 +158,14 @@ static Source appKymeraCreateTonePromptChain(const KYMERA_INTERNAL_TONE_PROMPT_P
             OperatorsStandardSetSampleRate(op, msg->rate);
             OperatorsConfigureToneGenerator(op, msg->tone, &theKymera->task);
         }
-        ChainConnect(chain);
+
+        if (!cached_chain)
+        {
+            ChainConnect(chain);
+        }
         theKymera->chain_tone_handle = chain;
+        theKymera->tone_cache_config = config;
+        theKymera->tone_cache_rate = msg->rate;
     }
 
     if (is_prompt)
@@ -114,6 +190,7 @@ static Source appKymeraCreateTonePromptChain(const KYMERA_INTERNAL_TONE_PROMPT_P
 void appKymeraHandleInternalTonePromptPlay(const KYMERA_INTERNAL_TONE_PROMPT_PLAY_T *msg)
 {
     kymeraTaskData *theKymera = KymeraGetTaskData();
+    uint32 start_time = VmGetClock();
     Operator op;
 
     DEBUG_LOGF("appKymeraHandleInternalTonePromptPlay, prompt %x, tone %p, int %u, lock 0x%x, mask 0x%x",
@@ -172,6 +249,9 @@ void appKymeraHandleInternalTonePromptPlay(const KYMERA_INTERNAL_TONE_PROMPT_PLA
             Panic();
             break;
     }
+    theKymera->tone_setup_time_ms = (uint16)(VmGetClock() - start_time);
+    DEBUG_LOGF("appKymeraHandleInternalTonePromptPlay, started in %ums", theKymera->tone_setup_time_ms);
+
     if (!msg->interruptible)
     {
         appKymeraSetToneLock(theKymera);
@@ -201,6 +281,9 @@ void appKymeraTonePromptStop(void)
         {
             Operator op = ChainGetOperatorByRole(theKymera->chainu.output_vol_handle, OPR_VOLUME_CONTROL);
             uint16 volume = volTo60thDbGain(0);
+            /* A prompt cut off before the end of its file leaves encoded
+               audio in the chain's buffers */
+            bool interrupted = theKymera->prompt_source && SourceSize(theKymera->prompt_source);
             OperatorsVolumeSetAuxGain(op, volume);
 
             if (theKymera->prompt_source)
@@ -211,9 +294,28 @@ void appKymeraTonePromptStop(void)
 
             if (theKymera->chain_tone_handle)
             {
-                ChainStop(theKymera->chain_tone_handle);
-                ChainDestroy(theKymera->chain_tone_handle);
+                kymera_chain_handle_t chain = theKymera->chain_tone_handle;
+
+                ChainStop(chain);
                 theKymera->chain_tone_handle = NULL;
+
+                /* Only worth keeping the chain if something else is keeping
+                   the DSP running, otherwise it's destroyed with the output
+                   chain below. */
+                if (appConfigKymeraTonePromptCacheEnabled() &&
+                    appKymeraGetState() != KYMERA_STATE_TONE_PLAYING &&
+                    !interrupted)
+                {
+                    StreamDisconnect(ChainGetOutput(chain, EPR_TONE_PROMPT_CHAIN_OUT), NULL);
+                    /* Don't play the end of this tone/prompt with the next */
+                    ChainReset(chain);
+                    appKymeraTonePromptCachePut(chain, theKymera->tone_cache_config,
+                                                theKymera->tone_cache_rate);
+                }
+                else
+                {
+                    ChainDestroy(chain);
+                }
             }
 
             if (appKymeraGetState() != KYMERA_STATE_TONE_PLAYING)
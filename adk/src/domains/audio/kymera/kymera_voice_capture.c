@@ -71,6 +71,7 @@ static void kymera_ConfigureVoiceCaptureChain(va_audio_voice_capture_params_t *p
 static void kymera_CreateVoiceCaptureChain(va_audio_voice_capture_params_t *params)
 {
     PanicFalse(voice_capture_chain == NULL);
+    appKymeraTonePromptCacheRelease();
     voice_capture_chain = PanicNull(ChainCreate(kymera_GetChainConfig()));
     appKymeraConfigureDspPowerMode(FALSE);
     OperatorsFrameworkSetKickPeriod(KICK_PERIOD_VOICE);
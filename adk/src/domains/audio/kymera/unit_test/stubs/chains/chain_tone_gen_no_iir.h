@@ -0,0 +1,17 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host stand-in for the header generated from chain_tone_gen_no_iir.chain, the
+            configuration is defined by the test.
+*/
+
+#ifndef _CHAIN_TONE_GEN_NO_IIR_H__
+#define _CHAIN_TONE_GEN_NO_IIR_H__
+
+#include <chain.h>
+
+extern const chain_config_t chain_tone_gen_no_iir_config;
+
+#endif /* _CHAIN_TONE_GEN_NO_IIR_H__ */
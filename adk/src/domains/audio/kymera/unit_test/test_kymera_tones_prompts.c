@@ -0,0 +1,541 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for keeping the tone/prompt chain for reuse, run against
+            fakes of the chain library, operators and stream traps.
+*/
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "kymera_private.h"
+#include "test_kymera_tones_prompts.h"
+
+#include "chains/chain_tone_gen.h"
+#include "chains/chain_tone_gen_no_iir.h"
+#include "chains/chain_prompt_decoder.h"
+#include "chains/chain_prompt_decoder_no_iir.h"
+#include "chains/chain_prompt_pcm.h"
+
+#define OUTPUT_RATE     (48000)
+#define TONE_RATE       (8000)
+#define PROMPT_RATE     (16000)
+#define PROMPT_FILE     ((FILE_INDEX)5)
+
+/*! Most chains the tests create */
+#define MAX_CHAINS      (8)
+
+/*! Modelled time taken by each kind of DSP call, in milliseconds. The
+    clock only moves in these calls, so the time from a request to the
+    first sample depends only on the calls made on the way. */
+#define CHAIN_CREATE_MS         (6)
+#define CHAIN_CONNECT_MS        (2)
+#define CHAIN_DESTROY_MS        (3)
+#define CHAIN_START_MS          (1)
+#define CHAIN_RESET_MS          (1)
+#define OPERATOR_MESSAGE_MS     (1)
+#define FILE_SOURCE_MS          (1)
+
+kymeraTaskData app_kymera;
+
+const chain_config_t chain_tone_gen_config = {0};
+const chain_config_t chain_tone_gen_no_iir_config = {0};
+const chain_config_t chain_prompt_decoder_config = {0};
+const chain_config_t chain_prompt_decoder_no_iir_config = {0};
+const chain_config_t chain_prompt_pcm_config = {0};
+
+static const ringtone_note tone_a[] = { RINGTONE_END };
+static const ringtone_note tone_b[] = { RINGTONE_END };
+
+/*! A fake chain, recording what was done to it */
+struct kymera_chain_tag
+{
+    const chain_config_t *config;
+    bool created;
+    bool destroyed;
+    bool connected;
+    bool running;
+    unsigned resets;
+};
+
+static struct kymera_chain_tag chains[MAX_CHAINS];
+static unsigned num_chains;
+
+/*! Dummy stream ends, only their addresses are used */
+static int output_chain, tone_chain_output, prompt_source;
+
+static struct
+{
+    uint32 clock_ms;
+    /*! Time the tone/prompt chain was last started, and so produced its
+        first sample */
+    uint32 first_sample_ms;
+    unsigned resampler_rate_sets;
+    unsigned tone_gen_configures;
+    const ringtone_note *last_tone;
+    uint16 prompt_source_size;
+} fake;
+
+/******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static unsigned testKymera_ChainsAlive(void)
+{
+    unsigned alive = 0;
+
+    for (unsigned i = 0; i < num_chains; i++)
+    {
+        if (chains[i].created && !chains[i].destroyed)
+            alive++;
+    }
+    return alive;
+}
+
+static void testKymera_Play(const ringtone_note *tone, FILE_INDEX prompt, promptFormat format, uint32 rate)
+{
+    KYMERA_INTERNAL_TONE_PROMPT_PLAY_T msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.tone = tone;
+    msg.prompt = prompt;
+    msg.prompt_format = format;
+    msg.rate = rate;
+    msg.interruptible = TRUE;
+
+    app_kymera.tone_count++;
+    appKymeraHandleInternalTonePromptPlay(&msg);
+}
+
+/*! Play a tone or prompt and return the time from the request to its first
+    sample */
+static uint32 testKymera_TimeToFirstSample(const ringtone_note *tone, FILE_INDEX prompt, promptFormat format, uint32 rate)
+{
+    uint32 request_ms = fake.clock_ms;
+
+    fake.first_sample_ms = 0;
+    testKymera_Play(tone, prompt, format, rate);
+    return fake.first_sample_ms - request_ms;
+}
+
+static void testKymera_PlayTone(const ringtone_note *tone, uint32 rate)
+{
+    testKymera_Play(tone, FILE_NONE, PROMPT_FORMAT_PCM, rate);
+}
+
+static void testKymera_PlaySbcPrompt(void)
+{
+    testKymera_Play(NULL, PROMPT_FILE, PROMPT_FORMAT_SBC, PROMPT_RATE);
+}
+
+/******************************************************************************
+ * Tests
+ ******************************************************************************/
+void setUp(void)
+{
+    memset(&app_kymera, 0, sizeof(app_kymera));
+    memset(chains, 0, sizeof(chains));
+    memset(&fake, 0, sizeof(fake));
+    num_chains = 0;
+
+    /* A2DP is streaming, so the DSP is kept running by another chain */
+    app_kymera.state = KYMERA_STATE_A2DP_STREAMING;
+    app_kymera.output_rate = OUTPUT_RATE;
+    app_kymera.chainu.output_vol_handle = (kymera_chain_handle_t)&output_chain;
+}
+
+void tearDown(void)
+{
+    appKymeraTonePromptCacheRelease();
+}
+
+static void test_ToneChainKeptAndReused(void)
+{
+    kymera_chain_handle_t first;
+
+    testKymera_PlayTone(tone_a, TONE_RATE);
+    first = app_kymera.chain_tone_handle;
+    appKymeraTonePromptStop();
+
+    TEST_ASSERT_EQUAL(NULL, app_kymera.chain_tone_handle);
+    TEST_ASSERT_EQUAL(first, app_kymera.chain_tone_cache_handle);
+    TEST_ASSERT_EQUAL(1, first->resets);
+    TEST_ASSERT_EQUAL(FALSE, first->running);
+
+    testKymera_PlayTone(tone_b, TONE_RATE);
+
+    TEST_ASSERT_EQUAL(1, num_chains);
+    TEST_ASSERT_EQUAL(first, app_kymera.chain_tone_handle);
+    TEST_ASSERT_EQUAL(NULL, app_kymera.chain_tone_cache_handle);
+    TEST_ASSERT_EQUAL(TRUE, first->running);
+    /* The reset chain is configured again for the new tone */
+    TEST_ASSERT_EQUAL(2, fake.resampler_rate_sets);
+    TEST_ASSERT_EQUAL(2, fake.tone_gen_configures);
+    TEST_ASSERT_EQUAL(tone_b, fake.last_tone);
+
+    appKymeraTonePromptStop();
+}
+
+static void test_MismatchReleasesCacheBeforeCreate(void)
+{
+    testKymera_PlayTone(tone_a, TONE_RATE);
+    appKymeraTonePromptStop();
+
+    /* A tone at the output rate doesn't need the resampler, so needs a
+       different chain */
+    testKymera_PlayTone(tone_a, OUTPUT_RATE);
+
+    TEST_ASSERT_EQUAL(2, num_chains);
+    TEST_ASSERT_EQUAL(TRUE, chains[0].destroyed);
+    TEST_ASSERT_EQUAL(&chain_tone_gen_no_iir_config, app_kymera.chain_tone_handle->config);
+    TEST_ASSERT_EQUAL(1, testKymera_ChainsAlive());
+
+    appKymeraTonePromptStop();
+}
+
+static void test_CompletedPromptChainResetAndReused(void)
+{
+    kymera_chain_handle_t first;
+
+    testKymera_PlaySbcPrompt();
+    first = app_kymera.chain_tone_handle;
+    TEST_ASSERT_EQUAL(&chain_prompt_decoder_config, first->config);
+
+    /* The whole file was read */
+    fake.prompt_source_size = 0;
+    appKymeraTonePromptStop();
+
+    TEST_ASSERT_EQUAL(first, app_kymera.chain_tone_cache_handle);
+    TEST_ASSERT_EQUAL(1, first->resets);
+
+    testKymera_PlaySbcPrompt();
+
+    TEST_ASSERT_EQUAL(1, num_chains);
+    TEST_ASSERT_EQUAL(first, app_kymera.chain_tone_handle);
+    TEST_ASSERT_EQUAL(2, fake.resampler_rate_sets);
+
+    appKymeraTonePromptStop();
+}
+
+static void test_InterruptedPromptChainDestroyed(void)
+{
+    kymera_chain_handle_t first;
+
+    testKymera_PlaySbcPrompt();
+    first = app_kymera.chain_tone_handle;
+
+    /* Cut off with part of the file still to read */
+    fake.prompt_source_size = 64;
+    appKymeraTonePromptStop();
+
+    TEST_ASSERT_EQUAL(NULL, app_kymera.chain_tone_cache_handle);
+    TEST_ASSERT_EQUAL(TRUE, first->destroyed);
+
+    fake.prompt_source_size = 0;
+    testKymera_PlaySbcPrompt();
+
+    TEST_ASSERT_EQUAL(2, num_chains);
+    TEST_ASSERT_EQUAL(1, testKymera_ChainsAlive());
+
+    appKymeraTonePromptStop();
+}
+
+static void test_ToneOnlyChainNotKept(void)
+{
+    app_kymera.state = KYMERA_STATE_IDLE;
+    app_kymera.output_rate = 0;
+
+    testKymera_PlayTone(tone_a, TONE_RATE);
+    TEST_ASSERT_EQUAL(KYMERA_STATE_TONE_PLAYING, app_kymera.state);
+    appKymeraTonePromptStop();
+
+    TEST_ASSERT_EQUAL(KYMERA_STATE_IDLE, app_kymera.state);
+    TEST_ASSERT_EQUAL(NULL, app_kymera.chain_tone_cache_handle);
+    TEST_ASSERT_EQUAL(0, testKymera_ChainsAlive());
+}
+
+static void test_ReleaseDestroysCachedChain(void)
+{
+    testKymera_PlayTone(tone_a, TONE_RATE);
+    appKymeraTonePromptStop();
+    TEST_ASSERT_EQUAL(1, testKymera_ChainsAlive());
+
+    appKymeraTonePromptCacheRelease();
+
+    TEST_ASSERT_EQUAL(NULL, app_kymera.chain_tone_cache_handle);
+    TEST_ASSERT_EQUAL(0, testKymera_ChainsAlive());
+
+    /* Nothing left to release */
+    appKymeraTonePromptCacheRelease();
+    TEST_ASSERT_EQUAL(1, num_chains);
+}
+
+static void test_ToneTimeToFirstSample(void)
+{
+    uint32 cold_ms, cached_ms;
+
+    cold_ms = testKymera_TimeToFirstSample(tone_a, FILE_NONE, PROMPT_FORMAT_PCM, TONE_RATE);
+    TEST_ASSERT_EQUAL(cold_ms, app_kymera.tone_setup_time_ms);
+    appKymeraTonePromptStop();
+
+    cached_ms = testKymera_TimeToFirstSample(tone_b, FILE_NONE, PROMPT_FORMAT_PCM, TONE_RATE);
+    TEST_ASSERT_EQUAL(cached_ms, app_kymera.tone_setup_time_ms);
+    appKymeraTonePromptStop();
+
+    /* The cached chain skips creating and connecting the chain */
+    TEST_ASSERT_EQUAL(cold_ms - CHAIN_CREATE_MS - CHAIN_CONNECT_MS, cached_ms);
+
+    printf("Tone request to first sample: new chain %lu ms, cached chain %lu ms\n",
+           (unsigned long)cold_ms, (unsigned long)cached_ms);
+}
+
+static void test_PromptTimeToFirstSample(void)
+{
+    uint32 cold_ms, cached_ms;
+
+    cold_ms = testKymera_TimeToFirstSample(NULL, PROMPT_FILE, PROMPT_FORMAT_SBC, PROMPT_RATE);
+    TEST_ASSERT_EQUAL(cold_ms, app_kymera.tone_setup_time_ms);
+    appKymeraTonePromptStop();
+
+    cached_ms = testKymera_TimeToFirstSample(NULL, PROMPT_FILE, PROMPT_FORMAT_SBC, PROMPT_RATE);
+    TEST_ASSERT_EQUAL(cached_ms, app_kymera.tone_setup_time_ms);
+    appKymeraTonePromptStop();
+
+    TEST_ASSERT_EQUAL(cold_ms - CHAIN_CREATE_MS - CHAIN_CONNECT_MS, cached_ms);
+
+    printf("SBC prompt request to first sample: new chain %lu ms, cached chain %lu ms\n",
+           (unsigned long)cold_ms, (unsigned long)cached_ms);
+}
+
+void test_kymera_tones_prompts(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ToneChainKeptAndReused);
+    RUN_TEST(test_MismatchReleasesCacheBeforeCreate);
+    RUN_TEST(test_CompletedPromptChainResetAndReused);
+    RUN_TEST(test_InterruptedPromptChainDestroyed);
+    RUN_TEST(test_ToneOnlyChainNotKept);
+    RUN_TEST(test_ReleaseDestroysCachedChain);
+    RUN_TEST(test_ToneTimeToFirstSample);
+    RUN_TEST(test_PromptTimeToFirstSample);
+
+    UNITY_END();
+}
+
+/******************************************************************************
+ * Chain library fakes
+ ******************************************************************************/
+kymera_chain_handle_t ChainCreate(const chain_config_t *config)
+{
+    kymera_chain_handle_t chain;
+
+    if (num_chains == MAX_CHAINS)
+        Panic();
+
+    fake.clock_ms += CHAIN_CREATE_MS;
+    chain = &chains[num_chains++];
+    chain->config = config;
+    chain->created = TRUE;
+    return chain;
+}
+
+void ChainDestroy(kymera_chain_handle_t handle)
+{
+    if (!handle->created || handle->destroyed || handle->running)
+        Panic();
+    fake.clock_ms += CHAIN_DESTROY_MS;
+    handle->destroyed = TRUE;
+}
+
+void ChainConnect(kymera_chain_handle_t handle)
+{
+    fake.clock_ms += CHAIN_CONNECT_MS;
+    handle->connected = TRUE;
+}
+
+bool ChainConnectInput(kymera_chain_handle_t handle, Source source, unsigned input_role)
+{
+    UNUSED(handle);
+    UNUSED(input_role);
+    return source != NULL;
+}
+
+void ChainStart(kymera_chain_handle_t handle)
+{
+    fake.clock_ms += CHAIN_START_MS;
+    if (handle != app_kymera.chainu.output_vol_handle)
+    {
+        if (!handle->connected || handle->destroyed)
+            Panic();
+        handle->running = TRUE;
+        fake.first_sample_ms = fake.clock_ms;
+    }
+}
+
+void ChainStop(kymera_chain_handle_t handle)
+{
+    handle->running = FALSE;
+}
+
+void ChainReset(kymera_chain_handle_t handle)
+{
+    if (handle->running)
+        Panic();
+    fake.clock_ms += CHAIN_RESET_MS;
+    handle->resets++;
+}
+
+Operator ChainGetOperatorByRole(kymera_chain_handle_t handle, unsigned operator_role)
+{
+    UNUSED(handle);
+    return (Operator)(operator_role + 1);
+}
+
+Source ChainGetOutput(kymera_chain_handle_t handle, unsigned output_role)
+{
+    UNUSED(handle);
+    UNUSED(output_role);
+    return (Source)&tone_chain_output;
+}
+
+/******************************************************************************
+ * Operators library fakes
+ ******************************************************************************/
+void OperatorsResamplerSetConversionRate(Operator opid, unsigned input_sample_rate,
+                                         unsigned output_sample_rate)
+{
+    UNUSED(opid);
+    if (output_sample_rate != app_kymera.output_rate || input_sample_rate == output_sample_rate)
+        Panic();
+    fake.clock_ms += OPERATOR_MESSAGE_MS;
+    fake.resampler_rate_sets++;
+}
+
+void OperatorsStandardSetSampleRate(Operator op, unsigned sample_rate)
+{
+    UNUSED(op);
+    UNUSED(sample_rate);
+    fake.clock_ms += OPERATOR_MESSAGE_MS;
+}
+
+void OperatorsConfigureToneGenerator(Operator op, const ringtone_note *tone, Task listener)
+{
+    UNUSED(op);
+    UNUSED(listener);
+    fake.clock_ms += OPERATOR_MESSAGE_MS;
+    fake.tone_gen_configures++;
+    fake.last_tone = tone;
+}
+
+void OperatorsVolumeMute(Operator op, bool enable)
+{
+    UNUSED(op);
+    UNUSED(enable);
+    fake.clock_ms += OPERATOR_MESSAGE_MS;
+}
+
+void OperatorsVolumeSetAuxGain(Operator op, int gain)
+{
+    UNUSED(op);
+    UNUSED(gain);
+    fake.clock_ms += OPERATOR_MESSAGE_MS;
+}
+
+void OperatorsVolumeSetMainGain(Operator op, int gain)
+{
+    UNUSED(op);
+    UNUSED(gain);
+    fake.clock_ms += OPERATOR_MESSAGE_MS;
+}
+
+/******************************************************************************
+ * Kymera fakes
+ ******************************************************************************/
+void appKymeraSetState(appKymeraState state)
+{
+    app_kymera.state = state;
+}
+
+void appKymeraCreateOutputChain(unsigned kick_period, unsigned buffer_size, int16 volume_in_db)
+{
+    UNUSED(kick_period);
+    UNUSED(buffer_size);
+    UNUSED(volume_in_db);
+    app_kymera.chainu.output_vol_handle = (kymera_chain_handle_t)&output_chain;
+}
+
+void appKymeraDestroyOutputChain(void)
+{
+    app_kymera.chainu.output_vol_handle = NULL;
+}
+
+void appKymeraExternalAmpControl(bool enable)
+{
+    UNUSED(enable);
+}
+
+void appKymeraConfigureDspPowerMode(bool tone_playing)
+{
+    UNUSED(tone_playing);
+}
+
+int32 volTo60thDbGain(int16 volume)
+{
+    return volume * KYMERA_DB_SCALE;
+}
+
+/******************************************************************************
+ * Trap fakes
+ ******************************************************************************/
+Source StreamFileSource(FILE_INDEX index)
+{
+    fake.clock_ms += FILE_SOURCE_MS;
+    return (index == PROMPT_FILE) ? (Source)&prompt_source : NULL;
+}
+
+uint16 SourceSize(Source source)
+{
+    UNUSED(source);
+    return fake.prompt_source_size;
+}
+
+bool SourceClose(Source source)
+{
+    UNUSED(source);
+    return TRUE;
+}
+
+void StreamDisconnect(Source source, Sink sink)
+{
+    UNUSED(source);
+    UNUSED(sink);
+}
+
+Task MessageStreamTaskFromSource(Source source, Task task)
+{
+    UNUSED(source);
+    UNUSED(task);
+    return NULL;
+}
+
+uint32 VmGetClock(void)
+{
+    return fake.clock_ms;
+}
+
+void Panic(void)
+{
+    printf("PANIC\n");
+    abort();
+}
+
+void *PanicNull(void *pointer)
+{
+    if (pointer == NULL)
+        Panic();
+    return pointer;
+}
@@ -0,0 +1,19 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the tone/prompt chain cache.
+*/
+
+#ifndef TEST_KYMERA_TONES_PROMPTS_H_
+#define TEST_KYMERA_TONES_PROMPTS_H_
+
+/*! \brief Test runner for kymera_tones_prompts.c.
+
+    Plays tones and prompts while another chain is keeping the DSP running,
+    and checks when the stopped chain is kept, reset, reused and destroyed.
+*/
+void test_kymera_tones_prompts(void);
+
+#endif /* TEST_KYMERA_TONES_PROMPTS_H_ */
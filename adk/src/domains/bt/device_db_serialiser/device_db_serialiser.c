@@ -33,19 +33,72 @@ typedef struct
     get_persistent_device_data_len_bits get_len;
     serialise_persistent_device_data ser;
     deserialise_persistent_device_data deser;
+    uint8 len;  /*!< Length of this PDDU's frame for the device being serialised */
 
 } device_db_serialiser_registered_pddu_t;
 
+/*! \brief Devices with properties changed since they were last serialised.
+
+    If more devices change than there are entries, all_devices_dirty is set
+    and the next serialise writes every device.
+*/
+typedef struct
+{
+    device_t devices[MAX_NUM_DEVICES_IN_PDL];
+    uint8 num_devices;
+    bool all_devices_dirty;
+} device_db_serialiser_dirty_t;
+
 device_db_serialiser_registered_pddu_t *registered_pddu_list = NULL;
 
 uint8 num_registered_pddus = 0;
 
 static bool deserialised = FALSE;
 
+/* Set while the PDL is being read, so restored properties don't mark devices dirty */
+static bool deserialising = FALSE;
+
+/* Nothing is known about what is in the PDL at boot, so the first serialise writes everything */
+static device_db_serialiser_dirty_t dirty = { {0}, 0, TRUE };
+
+/* PDD frame buffer, kept between serialisations and only grown when needed */
+static uint8 *pdd_frame_buffer = NULL;
+static uint16 pdd_frame_buffer_size = 0;
+
+static bool deviceDbSerialiser_isDeviceDirty(device_t device)
+{
+    if (dirty.all_devices_dirty)
+        return TRUE;
+
+    for (int i=0; i<dirty.num_devices; i++)
+    {
+        if (dirty.devices[i] == device)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static void deviceDbSerialiser_PropertyChanged(device_t device, device_property_t id)
+{
+    UNUSED(id);
+
+    if (deserialising || deviceDbSerialiser_isDeviceDirty(device))
+        return;
+
+    if (dirty.num_devices < MAX_NUM_DEVICES_IN_PDL)
+        dirty.devices[dirty.num_devices++] = device;
+    else
+        dirty.all_devices_dirty = TRUE;
+}
+
 void DeviceDbSerialiser_Init(void)
 {
     num_registered_pddus = 0;
     deserialised = FALSE;
+    deserialising = FALSE;
+    dirty.num_devices = 0;
+    dirty.all_devices_dirty = TRUE;
 }
 
 void DeviceDbSerialiser_RegisterPersistentDeviceDataUser(
@@ -61,6 +114,7 @@ void DeviceDbSerialiser_RegisterPersistentDeviceDataUser(
     if (!registered_pddu_list)
     {
        registered_pddu_list = (device_db_serialiser_registered_pddu_t*)PanicUnlessMalloc(sizeof(device_db_serialiser_registered_pddu_t));
+       Device_RegisterPropertyChangedCallback(deviceDbSerialiser_PropertyChanged);
     }
     else
     {
@@ -76,25 +130,29 @@ void DeviceDbSerialiser_RegisterPersistentDeviceDataUser(
     num_registered_pddus++;
 }
 
-static uint8 * deviceDbSerialiser_getAllPddusPayloadLengths(device_t device)
+static void deviceDbSerialiser_getAllPddusPayloadLengths(device_t device)
 {
-    uint8 *pddus_len = (uint8 *)PanicUnlessMalloc(num_registered_pddus*sizeof(uint8));
-
     for (int i=0; i<num_registered_pddus; i++)
     {
         uint8 pdd_len = registered_pddu_list[i].get_len(device);
         if (pdd_len)
             pdd_len += SIZE_OF_TYPE_AND_LEN;
-        pddus_len[registered_pddu_list[i].id] = pdd_len;
+        registered_pddu_list[i].len = pdd_len;
     }
-
-    return pddus_len;
 }
 
 static uint8 * deviceDbSerialiser_createPddFrame(uint16 total_len)
 {
     total_len += SIZE_OF_TYPE_AND_LEN;
-    uint8 * buffer = (uint8 *)PanicUnlessMalloc(total_len);
+
+    if (total_len > pdd_frame_buffer_size)
+    {
+        free(pdd_frame_buffer);
+        pdd_frame_buffer = (uint8 *)PanicUnlessMalloc(total_len);
+        pdd_frame_buffer_size = total_len;
+    }
+
+    uint8 * buffer = pdd_frame_buffer;
 
     buffer[TYPE_OFFSET_IN_FRAME] = DBS_PDD_FRAME_TYPE;
     buffer[LEN_OFFSET_IN_FRAME] = total_len;
@@ -109,7 +167,7 @@ static void deviceDbSerialiser_addPdduData(device_t device, device_db_serialiser
     pddu->ser(device, &payload[PAYLOAD_OFFSET_IN_FRAME], 0);
 }
 
-static void deviceDbSerialiser_populatePddFrame(device_t device, uint8 * pdd_frame, uint8 *pddus_len)
+static void deviceDbSerialiser_populatePddFrame(device_t device, uint8 * pdd_frame)
 {
     uint8 offset = 0;
     uint8 * payload = pdd_frame + PAYLOAD_OFFSET_IN_FRAME;
@@ -118,24 +176,23 @@ static void deviceDbSerialiser_populatePddFrame(device_t device, uint8 * pdd_fra
     {
         device_db_serialiser_registered_pddu_t *curr_pddu = &registered_pddu_list[i];
 
-        deviceDbSerialiser_addPdduData(device, curr_pddu, &payload[offset], pddus_len[curr_pddu->id]);
+        deviceDbSerialiser_addPdduData(device, curr_pddu, &payload[offset], curr_pddu->len);
 
-        offset += pddus_len[curr_pddu->id];
+        offset += curr_pddu->len;
     }
 }
 
-static inline uint16 deviceDbSerialiser_sumAllPdduPayloads(uint8 *pddus_payload_lengths)
+static inline uint16 deviceDbSerialiser_sumAllPdduPayloads(void)
 {
     uint8 sum_of_individual_pddu_frames = 0;
     for (int pddu_index=0; pddu_index<num_registered_pddus; pddu_index++)
-        sum_of_individual_pddu_frames += pddus_payload_lengths[pddu_index];
+        sum_of_individual_pddu_frames += registered_pddu_list[pddu_index].len;
     return sum_of_individual_pddu_frames;
 }
 
 static void deviceDbSerialiser_SerialiseDevice(device_t device, void *data)
 {
     uint8 pdd_frame_payload_len = 0;
-    uint8 *pddus_payload_lengths = NULL;
     bdaddr *device_bdaddr = NULL;
     size_t bdaddr_size;
 
@@ -144,33 +201,39 @@ static void deviceDbSerialiser_SerialiseDevice(device_t device, void *data)
     if (!registered_pddu_list)
         return;
 
+    if (!deviceDbSerialiser_isDeviceDirty(device))
+        return;
+
     // Only store bluetooth devices in the PDL, so the device must have a bdaddr
     if (!Device_GetProperty(device, device_property_bdaddr, (void *)&device_bdaddr, &bdaddr_size))
         return;
 
     PanicFalse(bdaddr_size == sizeof(bdaddr));
 
-    pddus_payload_lengths = deviceDbSerialiser_getAllPddusPayloadLengths(device);
+    deviceDbSerialiser_getAllPddusPayloadLengths(device);
 
-    pdd_frame_payload_len = deviceDbSerialiser_sumAllPdduPayloads(pddus_payload_lengths);
+    pdd_frame_payload_len = deviceDbSerialiser_sumAllPdduPayloads();
 
     if (pdd_frame_payload_len)
     {
         uint8 *pdd_frame = deviceDbSerialiser_createPddFrame(pdd_frame_payload_len);
 
-        deviceDbSerialiser_populatePddFrame(device, pdd_frame, pddus_payload_lengths);
+        deviceDbSerialiser_populatePddFrame(device, pdd_frame);
 
+        /* The attribute is written to the PS synchronously, so the frame buffer
+           is free to be reused for the next device once this returns */
         ConnectionSmPutAttributeReq(0, TYPED_BDADDR_PUBLIC, device_bdaddr, pdd_frame[LEN_OFFSET_IN_FRAME], pdd_frame);
-
-        free(pdd_frame);
     }
-
-    free(pddus_payload_lengths);
 }
 
 void DeviceDbSerialiser_Serialise(void)
 {
     DeviceList_Iterate(deviceDbSerialiser_SerialiseDevice, NULL);
+
+    /* Every device in the list is now up to date, and entries for devices
+       that have since been destroyed are no longer needed */
+    dirty.num_devices = 0;
+    dirty.all_devices_dirty = FALSE;
 }
 
 static device_db_serialiser_registered_pddu_t * deviceDbSerialiser_getRegisteredPddu(uint8 id)
@@ -235,6 +298,8 @@ void DeviceDbSerialiser_Deserialise(void)
 {
     if(!deserialised)
     {
+        deserialising = TRUE;
+
         for (uint8 pdl_index = 0; pdl_index < MAX_NUM_DEVICES_IN_PDL; pdl_index++)
         {
             uint16 pdd_frame_length = ConnectionSmGetIndexedAttributeSizeNowReq(pdl_index);
@@ -243,6 +308,7 @@ void DeviceDbSerialiser_Deserialise(void)
             free(pdd_frame);
         }
 
+        deserialising = FALSE;
         deserialised = TRUE;
     }
 }
@@ -49,6 +49,9 @@ void DeviceDbSerialiser_RegisterPersistentDeviceDataUser(
         deserialise_persistent_device_data deser);
 
 /*! \brief Serialise the set of Persistent Device Data.
+
+    Only devices with properties set or removed since they were last
+    serialised are written to the PDL.
 */
 void DeviceDbSerialiser_Serialise(void);
 
@@ -832,8 +832,24 @@ static bool leAdvertisingManager_Start(const le_advert_start_params_t * params)
         
         if(leAdvertisingManager_BuildData(start_params.set))
         {
-            leAdvertisingManager_SetupAdvertData();
-            adv_task_data->blockingCondition = ADV_SETUP_BLOCK_ADV_DATA_CFM;
+            if(!leAdvertisingManager_IsAdvertDataUnchanged())
+            {
+                leAdvertisingManager_SetupAdvertData();
+                adv_task_data->blockingCondition = ADV_SETUP_BLOCK_ADV_DATA_CFM;
+            }
+            else if(!leAdvertisingManager_IsScanResponseDataUnchanged())
+            {
+                DEBUG_LOG_LEVEL_2("leAdvertisingManager_Start Info, Advertising data unchanged, only scan response data needs to be set");
+                leAdvertisingManager_SetupScanResponseData();
+                leAdvertisingManager_ClearData(start_params.set);
+                adv_task_data->blockingCondition = ADV_SETUP_BLOCK_ADV_SCAN_RESPONSE_DATA_CFM;
+            }
+            else
+            {
+                DEBUG_LOG_LEVEL_2("leAdvertisingManager_Start Info, Advertising and scan response data unchanged");
+                leAdvertisingManager_ClearData(start_params.set);
+                leAdvertisingManager_SetupAdvertParams(params);
+            }
         }
         else
         {
@@ -947,6 +963,7 @@ bool LeAdvertisingManager_Init(Task init_task)
     LeAdvertisingManagerSm_SetState(le_adv_mgr_state_initialised);
     
     leAdvertisingManager_ClientsInit();
+    leAdvertisingManager_ForgetSetupData();
     
     task_allow_all = 0;
     task_enable_connectable = 0;
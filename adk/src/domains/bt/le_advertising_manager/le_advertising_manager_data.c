@@ -79,6 +79,27 @@ static unsigned leAdvertisingManager_GetPacketSize(le_adv_data_packet_t* packet)
 static le_adv_data_packet_t* advert;
 static le_adv_data_packet_t* scan_rsp;
 
+/* Copies of the data last passed to the controller */
+static le_adv_data_packet_t last_advert;
+static le_adv_data_packet_t last_scan_rsp;
+static bool last_advert_valid;
+static bool last_scan_rsp_valid;
+
+static void leAdvertisingManager_RecordPacket(le_adv_data_packet_t* last, const le_adv_data_packet_t* packet)
+{
+    unsigned size = packet->head - packet->data;
+
+    memcpy(last->data, packet->data, size);
+    last->head = last->data + size;
+}
+
+static bool leAdvertisingManager_PacketIsSame(const le_adv_data_packet_t* last, const le_adv_data_packet_t* packet)
+{
+    unsigned size = packet->head - packet->data;
+
+    return ((unsigned)(last->head - last->data) == size) && (memcmp(last->data, packet->data, size) == 0);
+}
+
 static bool leAdvertisingManager_AddDataItemToAdvert(const le_adv_data_item_t* item)
 {
     DEBUG_LOG("leAdvertisingManager_AddDataItemToAdvert");
@@ -353,9 +374,17 @@ void leAdvertisingManager_SetupScanResponseData(void)
 
     leAdvertisingManager_DebugDataItems(size_scan_rsp, scan_rsp_start);
 
+    leAdvertisingManager_RecordPacket(&last_scan_rsp, scan_rsp);
+    last_scan_rsp_valid = TRUE;
+
     ConnectionDmBleSetScanResponseDataReq(size_scan_rsp, scan_rsp_start);
 }
 
+bool leAdvertisingManager_IsScanResponseDataUnchanged(void)
+{
+    return last_scan_rsp_valid && leAdvertisingManager_PacketIsSame(&last_scan_rsp, scan_rsp);
+}
+
 void leAdvertisingManager_SetupAdvertData(void)
 {
     uint8 size_advert = leAdvertisingManager_GetPacketSize(advert);
@@ -365,9 +394,23 @@ void leAdvertisingManager_SetupAdvertData(void)
 
     leAdvertisingManager_DebugDataItems(size_advert, advert_start);
 
+    leAdvertisingManager_RecordPacket(&last_advert, advert);
+    last_advert_valid = TRUE;
+
     ConnectionDmBleSetAdvertisingDataReq(size_advert, advert_start);
 }
 
+bool leAdvertisingManager_IsAdvertDataUnchanged(void)
+{
+    return last_advert_valid && leAdvertisingManager_PacketIsSame(&last_advert, advert);
+}
+
+void leAdvertisingManager_ForgetSetupData(void)
+{
+    last_advert_valid = FALSE;
+    last_scan_rsp_valid = FALSE;
+}
+
 void leAdvertisingManager_ClearData(le_adv_data_set_t set)
 {
     le_adv_data_params_t params;
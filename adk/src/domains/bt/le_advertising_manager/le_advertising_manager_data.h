@@ -37,6 +37,28 @@ void leAdvertisingManager_SetupScanResponseData(void);
  */
 void leAdvertisingManager_SetupAdvertData(void);
 
+/*!
+    Check if the advertising packet built with leAdvertisingManager_BuildData
+    is identical to the one last registered with leAdvertisingManager_SetupAdvertData
+    
+    \returns TRUE if the controller already holds the same advertising data
+ */
+bool leAdvertisingManager_IsAdvertDataUnchanged(void);
+
+/*!
+    Check if the scan response packet built with leAdvertisingManager_BuildData
+    is identical to the one last registered with leAdvertisingManager_SetupScanResponseData
+    
+    \returns TRUE if the controller already holds the same scan response data
+ */
+bool leAdvertisingManager_IsScanResponseDataUnchanged(void);
+
+/*!
+    Forget the data last registered with the controller, so that the next
+    build is always written
+ */
+void leAdvertisingManager_ForgetSetupData(void);
+
 /*!
     Clear advertising and scan response data packets
     Must be called to clear data created with
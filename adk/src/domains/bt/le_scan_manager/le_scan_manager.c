@@ -6,11 +6,16 @@
 \brief        Implementation of module managing le scanning.
 */
 
+/* Every advertising report is logged, so limit how far a busy radio
+   environment can flood the log */
+#define LOGGING_RATE_LIMIT  (20)
+
 #include "le_scan_manager_protected.h"
 
 #include <logging.h>
 #include <panic.h>
 #include <vmtypes.h>
+#include <vm.h>
 #include <stdlib.h>
 
 #include "task_list.h"
@@ -19,12 +24,13 @@
 
 #define leScanManagerConfigEnableScanning()  FALSE
 #define leScanManagerConfigEnableWhiteList()  FALSE
+/*! Time (ms) during which an identical advert from the same address is not re-delivered */
+#define leScanManagerConfigDuplicateWindowMs()  (500)
 
 
 /*! Macro to make a message based on type. */
 #define MAKE_MESSAGE(TYPE) TYPE##_T *message = PanicUnlessNew(TYPE##_T);
 #define MAKE_CL_MESSAGE_WITH_LEN(TYPE, LEN) TYPE##_T *message = (TYPE##_T *) PanicUnlessMalloc(sizeof(TYPE##_T) + LEN);
-#define MAKE_CL_MESSAGE_WITH_LEN_TO_TASK(TYPE, LEN) TYPE##_T *message_task = (TYPE##_T *) PanicUnlessMalloc(sizeof(TYPE##_T) + LEN);
 
 
 /*!< SM data structure */
@@ -67,6 +73,7 @@ static void leScanManager_HandleResume(Task task);
 static void leScanManager_HandleScanEnable(connection_lib_status status);
 static void leScanManager_HandleAdverts(const CL_DM_BLE_ADVERTISING_REPORT_IND_T* message);
 static void leScanManager_handleScanFailure(scanCommand cmd , Task req);
+static void leScanManager_ForgetRecentAdverts(le_scan_settings_t *settings);
 
 static bool leScanManager_addClient(Task client);
 static bool leScanManager_removeClient(Task client);
@@ -108,16 +115,35 @@ static void leScanManager_SendResumeCfm(Task task,le_scan_manager_status_t scan_
     MessageSend(task,LE_SCAN_MANAGER_RESUME_CFM,message);
 }
 
+/*! \brief Size the receivers array to hold every client plus the terminator.
+
+    Done when the client list changes, so delivering an advert to several
+    clients does not allocate.
+*/
+static void leScanManager_UpdateReceivers(void)
+{
+    le_scan_manager_data_t * sm_data = LeScanManagerGetTaskData();
+
+    free(sm_data->receivers);
+    sm_data->receivers = PanicUnlessMalloc((TaskList_Size(sm_data->client_list) + 1) * sizeof(Task));
+}
+
 static bool leScanManager_addClient(Task client)
 {
     le_scan_manager_data_t * sm_data = LeScanManagerGetTaskData();
-    return TaskList_AddTask(sm_data->client_list, client);
+    bool added = TaskList_AddTask(sm_data->client_list, client);
+
+    leScanManager_UpdateReceivers();
+    return added;
 }
 
 static bool leScanManager_removeClient(Task client)
 {
     le_scan_manager_data_t * sm_data = LeScanManagerGetTaskData();
-    return TaskList_RemoveTask(sm_data->client_list, client);
+    bool removed = TaskList_RemoveTask(sm_data->client_list, client);
+
+    leScanManager_UpdateReceivers();
+    return removed;
 }
 
 static void leScanManager_handleScanFailure(scanCommand cmd , Task req)
@@ -303,6 +329,7 @@ static le_scan_settings_t* leScanManager_AcquireScan(le_scan_interval_t scan_int
         }
         
         sm_data->active_settings[settings_index]->scan_task = task;
+        leScanManager_ForgetRecentAdverts(sm_data->active_settings[settings_index]);
 
         scan_settings = sm_data->active_settings[settings_index];
     }
@@ -478,6 +505,226 @@ static bool leScanManager_FilterAddress(const typed_bdaddr* scan_taddr)
     return FALSE;
 }
 
+/*! \brief Check if the advertising data satisfies an advertising filter.
+
+    The AD structures of type filter->ad_type are searched for the pattern,
+    starting at offset 0 and stepping by filter->interval, mirroring the
+    filter applied by the connection library.
+*/
+static bool leScanManager_AdvertMatchesFilter(const le_advertising_report_filter_t *filter,
+                                              const uint8 *data, uint16 size_data)
+{
+    uint16 index = 0;
+
+    if (filter->size_pattern == 0)
+    {
+        return TRUE;
+    }
+
+    while (index + 1 < size_data)
+    {
+        uint16 length = data[index];
+        const uint8 *ad_data = &data[index + 2];
+        uint16 size_ad_data;
+
+        if (length == 0 || index + 1 + length > size_data)
+        {
+            break;
+        }
+        size_ad_data = length - 1;
+
+        if (data[index + 1] == filter->ad_type)
+        {
+            uint16 offset = 0;
+
+            while (offset + filter->size_pattern <= size_ad_data)
+            {
+                if (memcmp(&ad_data[offset], filter->pattern, filter->size_pattern) == 0)
+                {
+                    return TRUE;
+                }
+                if (filter->interval == 0)
+                {
+                    break;
+                }
+                offset += filter->interval;
+            }
+        }
+        index += 1 + length;
+    }
+    return FALSE;
+}
+
+/*! \brief Get the scan settings of a client.
+
+    \return The settings, or NULL for a client that only enabled the scan
+            manager rather than starting a scan.
+*/
+static le_scan_settings_t *leScanManager_GetClientSettings(Task client)
+{
+    le_scan_manager_data_t* sm_data = LeScanManagerGetTaskData();
+    int settings_index;
+
+    for (settings_index = 0; settings_index < MAX_ACTIVE_SCANS; settings_index++)
+    {
+        le_scan_settings_t *settings = sm_data->active_settings[settings_index];
+
+        if ((settings != NULL) && (settings->scan_task == client))
+        {
+            return settings;
+        }
+    }
+    return NULL;
+}
+
+static uint16 leScanManager_HashAdvert(const CL_DM_BLE_ADVERTISING_REPORT_IND_T* scan)
+{
+    uint16 hash = 0x811C ^ scan->event_type;
+    uint16 index;
+
+    for (index = 0; index < scan->size_advertising_data; index++)
+    {
+        hash = (uint16)((hash ^ scan->advertising_data[index]) * 0x0193);
+    }
+    return hash;
+}
+
+/*! \brief Check if an advert was sent to a scan client recently and record it if not.
+
+    A repeat of an advert is only a duplicate if its RSSI is no stronger than
+    when it was sent, so clients tracking the best RSSI of a device still see
+    every improvement.
+
+    \return TRUE if the same advert from the same address was sent to the
+            client within leScanManagerConfigDuplicateWindowMs().
+*/
+static bool leScanManager_IsRecentDuplicate(le_scan_settings_t *settings,
+                                            const CL_DM_BLE_ADVERTISING_REPORT_IND_T* scan,
+                                            uint16 data_hash, uint32 now)
+{
+    le_scan_recent_advert_t *entry = NULL;
+    int index;
+
+    for (index = 0; index < LE_SCAN_MANAGER_RECENT_ADVERTS_SIZE; index++)
+    {
+        if (BdaddrTypedIsSame(&settings->recent_adverts[index].taddr, &scan->current_taddr))
+        {
+            entry = &settings->recent_adverts[index];
+
+            if ((entry->data_hash == data_hash) &&
+                (scan->rssi <= entry->rssi) &&
+                (now - entry->timestamp) < leScanManagerConfigDuplicateWindowMs())
+            {
+                return TRUE;
+            }
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        entry = &settings->recent_adverts[settings->recent_adverts_next];
+        entry->taddr = scan->current_taddr;
+        settings->recent_adverts_next = (settings->recent_adverts_next + 1) % LE_SCAN_MANAGER_RECENT_ADVERTS_SIZE;
+    }
+    entry->data_hash = data_hash;
+    entry->rssi = scan->rssi;
+    entry->timestamp = now;
+
+    return FALSE;
+}
+
+static void leScanManager_ForgetRecentAdverts(le_scan_settings_t *settings)
+{
+    int index;
+
+    for (index = 0; index < LE_SCAN_MANAGER_RECENT_ADVERTS_SIZE; index++)
+    {
+        BdaddrTypedSetEmpty(&settings->recent_adverts[index].taddr);
+    }
+    settings->recent_adverts_next = 0;
+}
+
+static LE_SCAN_MANAGER_ADV_REPORT_IND_T *leScanManager_CreateAdvertReport(const CL_DM_BLE_ADVERTISING_REPORT_IND_T* scan, size_t size)
+{
+    MAKE_CL_MESSAGE_WITH_LEN(LE_SCAN_MANAGER_ADV_REPORT_IND,size);
+
+    message->num_reports = scan->num_reports;
+    message->event_type =  scan->event_type;
+    message->rssi = scan->rssi;
+    message->size_advertising_data = scan->size_advertising_data;
+
+    memcpy(message->advertising_data, scan->advertising_data, scan->size_advertising_data);
+
+    message->current_taddr = scan->current_taddr;
+    message->permanent_taddr = scan->permanent_taddr;
+
+    return message;
+}
+
+/*! \brief Send an advert to every client it is for.
+
+    Clients that only enabled the scan manager receive every advert. Scan
+    clients receive the adverts matching their own filter, less those they
+    were sent recently. Receivers are picked before the report is allocated,
+    so adverts nobody wants cost no heap, and a single report is shared
+    between all of them.
+*/
+static void leScanManager_DeliverAdvert(const CL_DM_BLE_ADVERTISING_REPORT_IND_T* scan, size_t size)
+{
+    le_scan_manager_data_t *sm_data = LeScanManagerGetTaskData();
+    uint16 data_hash = leScanManager_HashAdvert(scan);
+    uint32 now = VmGetClock();
+    uint16 num_matched = 0;
+    uint16 num_receivers = 0;
+    Task client = NULL;
+
+    while (TaskList_Iterate(sm_data->client_list, &client))
+    {
+        le_scan_settings_t *settings = leScanManager_GetClientSettings(client);
+
+        if (settings == NULL)
+        {
+            num_matched++;
+            sm_data->receivers[num_receivers++] = client;
+        }
+        else if (leScanManager_AdvertMatchesFilter(&settings->filter,
+                                                   scan->advertising_data,
+                                                   scan->size_advertising_data))
+        {
+            num_matched++;
+            if (!leScanManager_IsRecentDuplicate(settings, scan, data_hash, now))
+            {
+                sm_data->receivers[num_receivers++] = client;
+            }
+        }
+    }
+
+    if (num_matched == 0)
+    {
+        sm_data->counters.filtered++;
+        return;
+    }
+
+    if (num_receivers == 0)
+    {
+        sm_data->counters.duplicates++;
+        return;
+    }
+
+    sm_data->counters.delivered += num_receivers;
+
+    if (num_receivers == 1)
+    {
+        MessageSend(sm_data->receivers[0], LE_SCAN_MANAGER_ADV_REPORT_IND, leScanManager_CreateAdvertReport(scan, size));
+    }
+    else
+    {
+        sm_data->receivers[num_receivers] = NULL;
+        MessageSendMulticast(sm_data->receivers, LE_SCAN_MANAGER_ADV_REPORT_IND, leScanManager_CreateAdvertReport(scan, size));
+    }
+}
+
 static void leScanManager_HandleAdverts(const CL_DM_BLE_ADVERTISING_REPORT_IND_T* scan)
 {
     scanState current_state = LeScanManagerGetState();
@@ -496,51 +743,19 @@ static void leScanManager_HandleAdverts(const CL_DM_BLE_ADVERTISING_REPORT_IND_T
            return;
         }
 
-        
-        MAKE_CL_MESSAGE_WITH_LEN(LE_SCAN_MANAGER_ADV_REPORT_IND,size);
+        sm_data->counters.received++;
 
-        message->num_reports = scan->num_reports;
-        message->event_type =  scan->event_type;
-        message->rssi = scan->rssi;
-        message->size_advertising_data = scan->size_advertising_data;
-        
-        memcpy(message->advertising_data, scan->advertising_data, scan->size_advertising_data);
-
-        message->current_taddr.type =  scan->current_taddr.type;
-        message->current_taddr.addr.nap =  scan->current_taddr.addr.nap;
-        message->current_taddr.addr.uap =  scan->current_taddr.addr.uap;
-        message->current_taddr.addr.lap =  scan->current_taddr.addr.lap;
-
-        message->permanent_taddr.type =  scan->permanent_taddr.type;
-        message->permanent_taddr.addr.nap =  scan->permanent_taddr.addr.nap;
-        message->permanent_taddr.addr.uap =  scan->permanent_taddr.addr.uap;
-        message->permanent_taddr.addr.lap =  scan->permanent_taddr.addr.lap;
-        
-        TaskList_MessageSendWithSize(sm_data->client_list, LE_SCAN_MANAGER_ADV_REPORT_IND, message,size);
+        leScanManager_DeliverAdvert(scan, size);
 
         /* If client task is interested in finding specific device then resolve all RPA devices to check for a match */
         if((sm_data->confirmation_settings != NULL) && leScanManager_FilterAddress(&(scan->current_taddr)))
         {
-            MAKE_CL_MESSAGE_WITH_LEN_TO_TASK(LE_SCAN_MANAGER_ADV_REPORT_IND,size);
+            LE_SCAN_MANAGER_ADV_REPORT_IND_T *message_task = leScanManager_CreateAdvertReport(scan, size);
 
-            message_task->num_reports = scan->num_reports;
-            message_task->event_type =  scan->event_type;
-            message_task->rssi = scan->rssi;
-            message_task->size_advertising_data = scan->size_advertising_data;
-            
-            memcpy(message_task->advertising_data, scan->advertising_data, scan->size_advertising_data);
-
-            message_task->current_taddr.type =  scan->current_taddr.type;
-            message_task->current_taddr.addr.nap =  scan->current_taddr.addr.nap;
-            message_task->current_taddr.addr.uap =  scan->current_taddr.addr.uap;
-            message_task->current_taddr.addr.lap =  scan->current_taddr.addr.lap;
-        
-            message_task->permanent_taddr.type =  sm_data->confirmation_settings->filter.find_tpaddr->taddr.type;
-            message_task->permanent_taddr.addr.nap = sm_data->confirmation_settings->filter.find_tpaddr->taddr.addr.nap;
-            message_task->permanent_taddr.addr.uap = sm_data->confirmation_settings->filter.find_tpaddr->taddr.addr.uap;
-            message_task->permanent_taddr.addr.lap = sm_data->confirmation_settings->filter.find_tpaddr->taddr.addr.lap;
+            message_task->permanent_taddr = sm_data->confirmation_settings->filter.find_tpaddr->taddr;
 
             MessageSend(sm_data->confirmation_settings->scan_task, LE_SCAN_MANAGER_ADV_REPORT_IND, message_task);
+            sm_data->counters.delivered++;
             free(sm_data->confirmation_settings->filter.find_tpaddr);
             sm_data->confirmation_settings->filter.find_tpaddr = NULL;
         }
@@ -1054,6 +1269,7 @@ bool LeScanManager_Init(Task init_task)
 
     scanTask->is_paused = FALSE;
     scanTask->is_busy = FALSE;
+    leScanManager_UpdateReceivers();
     return TRUE;
 }
 
@@ -1137,3 +1353,25 @@ bool LeScanManager_IsTaskScanning(Task task)
 {
     return leScanManager_isDuplicate(task);
 }
+
+void LeScanManager_GetReportCounters(le_scan_manager_report_counters_t *counters)
+{
+    PanicNull(counters);
+    *counters = LeScanManagerGetTaskData()->counters;
+}
+
+void LeScanManager_ResetReportCounters(void)
+{
+    le_scan_manager_data_t *sm_data = LeScanManagerGetTaskData();
+    int settings_index;
+
+    memset(&sm_data->counters, 0, sizeof(sm_data->counters));
+
+    for (settings_index = 0; settings_index < MAX_ACTIVE_SCANS; settings_index++)
+    {
+        if (sm_data->active_settings[settings_index] != NULL)
+        {
+            leScanManager_ForgetRecentAdverts(sm_data->active_settings[settings_index]);
+        }
+    }
+}
@@ -12,6 +12,10 @@ Clients can request its own scan interval and advertising filter.
 
 Each advertising filter request is applied.
 Which means that a set of passed-through adverts is a combination of all client's requests.
+Each passed-through advert is then matched against every client's own filter and only
+delivered to the clients it matches. A scan client is not sent an identical advert from
+the same address again within a short window, unless its RSSI is stronger. Clients that
+only enabled the LE Scan Manager receive every advert.
 
 Whereas the scan interval is worked out by the LE Scan Manager.
 If at least one client requests fast scan interval then the scan interval will be fast.
@@ -123,6 +127,19 @@ typedef struct {
 /*! Advertisement Report to be sent to Application. */
 typedef CL_DM_BLE_ADVERTISING_REPORT_IND_T LE_SCAN_MANAGER_ADV_REPORT_IND_T;
 
+/*! \brief Counters of advertising reports handled by the LE Scan Manager. */
+typedef struct
+{
+    /*! Reports received from the connection library while scanning */
+    uint32 received;
+    /*! Reports not matching the filter of any client */
+    uint32 filtered;
+    /*! Reports suppressed as duplicates of a recently delivered report */
+    uint32 duplicates;
+    /*! Reports delivered, counted once per receiving client */
+    uint32 delivered;
+} le_scan_manager_report_counters_t;
+
 /*! \brief Function to handle the Events from Connecion Dispatcher */
 extern bool LeScanManager_HandleConnectionLibraryMessages(MessageId id, Message message,
                                                           bool already_handled);
@@ -234,6 +251,15 @@ void LeScanManager_Resume(Task task);
 */
 bool LeScanManager_IsTaskScanning(Task task);
 
+/*! \brief Get the advertising report counters.
+
+    \param[out] counters Filled in with the current counter values.
+*/
+void LeScanManager_GetReportCounters(le_scan_manager_report_counters_t *counters);
+
+/*! \brief Reset the advertising report counters and forget the adverts recently sent to scan clients. */
+void LeScanManager_ResetReportCounters(void);
+
 /*\}*/
 
 #endif /* LE_SCAN_MANAGER_H_ */
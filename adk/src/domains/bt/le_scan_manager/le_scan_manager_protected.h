@@ -54,12 +54,32 @@ typedef struct
     uint16  scan_window;
 } le_scan_parameters_t;
 
+/*! Number of adverts remembered per scan for duplicate suppression */
+#define LE_SCAN_MANAGER_RECENT_ADVERTS_SIZE     8
+
+/*! \brief Advert recently delivered to a scan client. */
+typedef struct
+{
+    /*! Address the advert was received from */
+    typed_bdaddr taddr;
+    /*! Hash of the event type and advertising data */
+    uint16 data_hash;
+    /*! RSSI of the advert when it was delivered */
+    int8 rssi;
+    /*! VM clock (ms) when the advert was delivered */
+    uint32 timestamp;
+} le_scan_recent_advert_t;
+
 /* \brief LE scan settings. */
 typedef struct
 {
     le_scan_interval_t scan_interval;
     le_advertising_report_filter_t  filter;
     Task scan_task;
+    /*! Adverts recently delivered to scan_task, used to suppress duplicates */
+    le_scan_recent_advert_t recent_adverts[LE_SCAN_MANAGER_RECENT_ADVERTS_SIZE];
+    /*! Index of the next entry in recent_adverts to be replaced */
+    uint8 recent_adverts_next;
 } le_scan_settings_t;
 
 /*! \brief LE scan manager task and state machine Strcuture. */
@@ -85,6 +105,10 @@ typedef struct
    bool is_busy;
    /*! List Of tasks which to get response of Adverts*/
    task_list_t    *client_list;  
+   /*! NULL terminated copy of client_list, the receivers of an advert */
+   Task *receivers;
+   /*! Advertising report counters */
+   le_scan_manager_report_counters_t counters;
 }le_scan_manager_data_t;   
 
 void leScanManager_Handler(Task task, MessageId id, Message message);
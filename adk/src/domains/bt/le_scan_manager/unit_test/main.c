@@ -0,0 +1,22 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      LE scan manager unit tests, built for the host with
+            DESKTOP_TEST_BUILD, see the Makefile.
+*/
+
+#include <stdio.h>
+#include "unity.h"
+#include "test_le_scan_manager.h"
+
+
+/* LE scan manager unit tests */
+int main (void)
+{
+    /* Test runner for test_le_scan_manager.c */
+    test_le_scan_manager();
+
+    return unity_failures ? 1 : 0;
+}
@@ -0,0 +1,417 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the delivery of advertising reports to LE scan clients,
+            run against fakes of the connection library and message traps.
+*/
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <panic.h>
+#include <vm.h>
+
+#include "le_scan_manager_protected.h"
+#include "local_addr.h"
+#include "test_le_scan_manager.h"
+
+#define RSSI_FAR        (-70)
+#define RSSI_NEAR       (-60)
+#define RSSI_NEARER     (-50)
+
+#define LAP_PEER        (0x111111)
+#define LAP_OTHER       (0x222222)
+
+/*! Duplicate window of the scan manager, leScanManagerConfigDuplicateWindowMs() */
+#define DUPLICATE_WINDOW_MS     (500)
+
+/*! Most clients the tests use */
+#define MAX_CLIENTS     (3)
+
+static TaskData client_a, client_b, client_enabler;
+
+static const uint8 uuid128_x[16] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+static const uint8 uuid128_z[16] = {0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88,
+                                    0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00};
+static const uint8 uuid16_y[2] = {0x0a, 0x18};
+
+/*! Reports sent to a client */
+typedef struct
+{
+    Task task;
+    unsigned reports;
+    int8 last_rssi;
+    /*! Address of the last report, to check reports are shared */
+    const void *last_report;
+} client_reports_t;
+
+static struct
+{
+    uint32 clock_ms;
+    /*! Scan enable requests not yet confirmed */
+    unsigned scan_enable_reqs;
+    /*! Heap allocations made through PanicUnlessMalloc */
+    unsigned allocations;
+    client_reports_t clients[MAX_CLIENTS];
+} fake;
+
+/******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static client_reports_t *testLeScanManager_Client(Task task)
+{
+    for (unsigned i = 0; i < MAX_CLIENTS; i++)
+    {
+        if (fake.clients[i].task == task)
+            return &fake.clients[i];
+    }
+    Panic();
+    return NULL;
+}
+
+static unsigned testLeScanManager_Reports(Task task)
+{
+    return testLeScanManager_Client(task)->reports;
+}
+
+/*! Confirm scan enable/disable requests until the scan manager stops making
+    them, as the connection library would */
+static void testLeScanManager_ConfirmScanEnable(void)
+{
+    CL_DM_BLE_SET_SCAN_ENABLE_CFM_T cfm = {.status = success};
+
+    while (fake.scan_enable_reqs)
+    {
+        fake.scan_enable_reqs--;
+        leScanManager_Handler(NULL, CL_DM_BLE_SET_SCAN_ENABLE_CFM, &cfm);
+    }
+}
+
+static void testLeScanManager_Start(Task task, ble_ad_type ad_type, const uint8 *pattern, uint16 size_pattern)
+{
+    le_advertising_report_filter_t filter;
+
+    memset(&filter, 0, sizeof(filter));
+    filter.ad_type = ad_type;
+    filter.interval = size_pattern;
+    filter.size_pattern = size_pattern;
+    filter.pattern = (uint8 *)pattern;
+
+    LeScanManager_Start(task, le_scan_interval_fast, &filter);
+    testLeScanManager_ConfirmScanEnable();
+}
+
+/*! Feed in an advert holding a single AD structure */
+static void testLeScanManager_Advert(uint32 lap, ble_ad_type ad_type, const uint8 *ad_data, uint8 size_ad_data, int8 rssi)
+{
+    uint8 size_advertising_data = size_ad_data + 2;
+    CL_DM_BLE_ADVERTISING_REPORT_IND_T *ind = malloc(sizeof(*ind) + size_advertising_data);
+
+    memset(ind, 0, sizeof(*ind));
+    ind->num_reports = 1;
+    ind->event_type = ble_adv_event_connectable_undirected;
+    ind->current_taddr.type = TYPED_BDADDR_PUBLIC;
+    ind->current_taddr.addr.lap = lap;
+    ind->permanent_taddr = ind->current_taddr;
+    ind->rssi = rssi;
+    ind->size_advertising_data = size_advertising_data;
+    ind->advertising_data[0] = size_ad_data + 1;
+    ind->advertising_data[1] = ad_type;
+    memcpy(&ind->advertising_data[2], ad_data, size_ad_data);
+
+    LeScanManager_HandleConnectionLibraryMessages(CL_DM_BLE_ADVERTISING_REPORT_IND, ind, FALSE);
+    free(ind);
+}
+
+static void testLeScanManager_PeerAdvert(int8 rssi)
+{
+    testLeScanManager_Advert(LAP_PEER, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x), rssi);
+}
+
+static void testLeScanManager_RecordReport(Task task, MessageId id, const void *message)
+{
+    if (id == LE_SCAN_MANAGER_ADV_REPORT_IND)
+    {
+        const LE_SCAN_MANAGER_ADV_REPORT_IND_T *report = message;
+        client_reports_t *client = testLeScanManager_Client(task);
+
+        client->reports++;
+        client->last_rssi = report->rssi;
+        client->last_report = report;
+    }
+}
+
+/******************************************************************************
+ * Tests
+ ******************************************************************************/
+void setUp(void)
+{
+    memset(&fake, 0, sizeof(fake));
+    fake.clients[0].task = &client_a;
+    fake.clients[1].task = &client_b;
+    fake.clients[2].task = &client_enabler;
+
+    LeScanManager_Init(NULL);
+}
+
+void tearDown(void)
+{
+}
+
+static void test_AdvertSentOnlyToMatchingClients(void)
+{
+    le_scan_manager_report_counters_t counters;
+
+    testLeScanManager_Start(&client_a, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+    testLeScanManager_Start(&client_b, ble_ad_type_complete_uuid16, uuid16_y, sizeof(uuid16_y));
+
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_a));
+    TEST_ASSERT_EQUAL(0, testLeScanManager_Reports(&client_b));
+
+    testLeScanManager_Advert(LAP_OTHER, ble_ad_type_complete_uuid16, uuid16_y, sizeof(uuid16_y), RSSI_NEAR);
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_a));
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_b));
+
+    /* Nobody is looking for this one, so no report is even allocated */
+    fake.allocations = 0;
+    testLeScanManager_Advert(LAP_OTHER, ble_ad_type_complete_uuid128, uuid128_z, sizeof(uuid128_z), RSSI_NEAR);
+    TEST_ASSERT_EQUAL(0, fake.allocations);
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_a));
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_b));
+
+    LeScanManager_GetReportCounters(&counters);
+    TEST_ASSERT_EQUAL(3, counters.received);
+    TEST_ASSERT_EQUAL(1, counters.filtered);
+    TEST_ASSERT_EQUAL(0, counters.duplicates);
+    TEST_ASSERT_EQUAL(2, counters.delivered);
+}
+
+static void test_RepeatSuppressedWithinWindow(void)
+{
+    le_scan_manager_report_counters_t counters;
+
+    testLeScanManager_Start(&client_a, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    fake.clock_ms += DUPLICATE_WINDOW_MS - 1;
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_a));
+
+    /* The window runs from the last report sent */
+    fake.clock_ms += 1;
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    TEST_ASSERT_EQUAL(2, testLeScanManager_Reports(&client_a));
+
+    /* The same data from another device is not a repeat */
+    testLeScanManager_Advert(LAP_OTHER, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x), RSSI_NEAR);
+    TEST_ASSERT_EQUAL(3, testLeScanManager_Reports(&client_a));
+
+    LeScanManager_GetReportCounters(&counters);
+    TEST_ASSERT_EQUAL(4, counters.received);
+    TEST_ASSERT_EQUAL(0, counters.filtered);
+    TEST_ASSERT_EQUAL(1, counters.duplicates);
+    TEST_ASSERT_EQUAL(3, counters.delivered);
+}
+
+static void test_StrongerRepeatDelivered(void)
+{
+    testLeScanManager_Start(&client_a, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    testLeScanManager_PeerAdvert(RSSI_NEARER);
+    TEST_ASSERT_EQUAL(2, testLeScanManager_Reports(&client_a));
+    TEST_ASSERT_EQUAL(RSSI_NEARER, testLeScanManager_Client(&client_a)->last_rssi);
+
+    /* Weaker than the best seen, so nothing new for the client */
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    testLeScanManager_PeerAdvert(RSSI_FAR);
+    TEST_ASSERT_EQUAL(2, testLeScanManager_Reports(&client_a));
+}
+
+static void test_DuplicatesTrackedPerClient(void)
+{
+    testLeScanManager_Start(&client_a, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+
+    /* A client starting to scan is sent the advert the other one has just had */
+    testLeScanManager_Start(&client_b, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_a));
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_b));
+}
+
+static void test_EnablingClientSentEveryAdvert(void)
+{
+    testLeScanManager_Start(&client_a, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+
+    LeScanManager_Disable(&client_enabler);
+    testLeScanManager_ConfirmScanEnable();
+    LeScanManager_Enable(&client_enabler);
+    testLeScanManager_ConfirmScanEnable();
+
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    testLeScanManager_Advert(LAP_OTHER, ble_ad_type_complete_uuid128, uuid128_z, sizeof(uuid128_z), RSSI_NEAR);
+
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_a));
+    TEST_ASSERT_EQUAL(3, testLeScanManager_Reports(&client_enabler));
+}
+
+static void test_ReportSharedBetweenClients(void)
+{
+    testLeScanManager_Start(&client_a, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+    testLeScanManager_Start(&client_b, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+
+    /* One allocation, the report, however many clients it goes to */
+    fake.allocations = 0;
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+
+    TEST_ASSERT_EQUAL(1, fake.allocations);
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_a));
+    TEST_ASSERT_EQUAL(1, testLeScanManager_Reports(&client_b));
+    TEST_ASSERT(testLeScanManager_Client(&client_a)->last_report == testLeScanManager_Client(&client_b)->last_report);
+}
+
+static void test_ResetForgetsRecentAdverts(void)
+{
+    le_scan_manager_report_counters_t counters;
+
+    testLeScanManager_Start(&client_a, ble_ad_type_complete_uuid128, uuid128_x, sizeof(uuid128_x));
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+
+    LeScanManager_ResetReportCounters();
+    LeScanManager_GetReportCounters(&counters);
+    TEST_ASSERT_EQUAL(0, counters.received);
+    TEST_ASSERT_EQUAL(0, counters.duplicates);
+    TEST_ASSERT_EQUAL(0, counters.delivered);
+
+    testLeScanManager_PeerAdvert(RSSI_NEAR);
+    TEST_ASSERT_EQUAL(2, testLeScanManager_Reports(&client_a));
+
+    LeScanManager_GetReportCounters(&counters);
+    TEST_ASSERT_EQUAL(1, counters.received);
+    TEST_ASSERT_EQUAL(1, counters.delivered);
+}
+
+void test_le_scan_manager(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_AdvertSentOnlyToMatchingClients);
+    RUN_TEST(test_RepeatSuppressedWithinWindow);
+    RUN_TEST(test_StrongerRepeatDelivered);
+    RUN_TEST(test_DuplicatesTrackedPerClient);
+    RUN_TEST(test_EnablingClientSentEveryAdvert);
+    RUN_TEST(test_ReportSharedBetweenClients);
+    RUN_TEST(test_ResetForgetsRecentAdverts);
+
+    UNITY_END();
+}
+
+/******************************************************************************
+ * Connection library fakes
+ ******************************************************************************/
+void ConnectionDmBleSetScanEnableReq(Task theAppTask, bool enable)
+{
+    UNUSED(theAppTask);
+    UNUSED(enable);
+    fake.scan_enable_reqs++;
+}
+
+void ConnectionDmBleSetScanParametersReq(bool enable_active_scanning, uint8 own_address, bool white_list_only,
+                                         uint16 scan_interval, uint16 scan_window)
+{
+    UNUSED(enable_active_scanning);
+    UNUSED(own_address);
+    UNUSED(white_list_only);
+    UNUSED(scan_interval);
+    UNUSED(scan_window);
+}
+
+bool ConnectionBleAddAdvertisingReportFilter(ble_ad_type ad_type, uint16 interval, uint16 size_pattern, const uint8* pattern)
+{
+    UNUSED(ad_type);
+    UNUSED(interval);
+    UNUSED(size_pattern);
+    UNUSED(pattern);
+    return TRUE;
+}
+
+bool ConnectionBleClearAdvertisingReportFilter(void)
+{
+    return TRUE;
+}
+
+uint8 LocalAddr_GetBleType(void)
+{
+    return 0;
+}
+
+/******************************************************************************
+ * Trap fakes
+ ******************************************************************************/
+void MessageSend(Task task, MessageId id, void *message)
+{
+    testLeScanManager_RecordReport(task, id, message);
+    free(message);
+}
+
+void MessageSendMulticast(Task *tasks, MessageId id, void *message)
+{
+    for (; *tasks; tasks++)
+    {
+        testLeScanManager_RecordReport(*tasks, id, message);
+    }
+    free(message);
+}
+
+void MessageSendMulticastLater(Task *tasks, MessageId id, void *message, uint32 delay)
+{
+    UNUSED(delay);
+    MessageSendMulticast(tasks, id, message);
+}
+
+uint32 VmGetClock(void)
+{
+    return fake.clock_ms;
+}
+
+bool VmGetPublicAddress(const tp_bdaddr *random_addr, tp_bdaddr *public_addr)
+{
+    UNUSED(random_addr);
+    UNUSED(public_addr);
+    return FALSE;
+}
+
+void Panic(void)
+{
+    printf("PANIC\n");
+    abort();
+}
+
+void *PanicNull(void *pointer)
+{
+    if (pointer == NULL)
+        Panic();
+    return pointer;
+}
+
+void PanicNotNull(const void *pointer)
+{
+    if (pointer != NULL)
+        Panic();
+}
+
+void *PanicUnlessMalloc(size_t size)
+{
+    fake.allocations++;
+    return PanicNull(malloc(size));
+}
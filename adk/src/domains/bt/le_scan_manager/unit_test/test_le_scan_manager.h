@@ -0,0 +1,20 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the delivery of advertising reports to LE scan clients.
+*/
+
+#ifndef TEST_LE_SCAN_MANAGER_H_
+#define TEST_LE_SCAN_MANAGER_H_
+
+/*! \brief Test runner for le_scan_manager.c.
+
+    Starts scans with different filters and feeds in advertising reports,
+    checking which clients are sent each report, the suppression of
+    duplicates and the report counters.
+*/
+void test_le_scan_manager(void);
+
+#endif /* TEST_LE_SCAN_MANAGER_H_ */
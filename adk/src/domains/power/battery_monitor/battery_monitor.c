@@ -12,6 +12,7 @@
 #include "earbud.h"
 #include "battery_monitor.h"
 #include "battery_monitor_config.h"
+#include "charger_monitor.h"
 #include "earbud_init.h"
 #include "earbud_test.h"
 #include "hydra_macros.h"
@@ -251,15 +252,69 @@ static void appBatteryServiceClients(batteryTaskData *battery)
     }
 }
 
+/* TRUE if the voltage is close to one of the battery level thresholds */
+static bool appBatteryNearThreshold(uint16 voltage)
+{
+    uint16 margin = appConfigBatteryThresholdMarginMv();
+
+    return !thresholdExceeded(voltage, appConfigBatteryVoltageCritical(), margin) ||
+           !thresholdExceeded(voltage, appConfigBatteryVoltageLow(), margin) ||
+           !thresholdExceeded(voltage, appConfigBatteryVoltageOk(), margin);
+}
+
+/*! Choose the period before the next reading.
+
+    While the voltage is stable the period doubles each time a full filter
+    length of readings agrees with the filtered voltage, up to
+    appConfigBatteryReadPeriodMaxMs(). It drops back to the base period when
+    a reading moves away from the filtered voltage, the voltage is near a
+    level threshold, or a charger is connected. */
+static void appBatteryAdaptPeriod(batteryTaskData *battery, uint16 vbatt_mv)
+{
+    uint16 filtered = (uint16)(battery->filter.accumulator / BATTERY_FILTER_LEN);
+    uint16 max_period = MAX(battery->period, appConfigBatteryReadPeriodMaxMs());
+
+    if (thresholdExceeded(vbatt_mv, filtered, appConfigBatteryStableMarginMv()) ||
+        appBatteryNearThreshold(filtered) ||
+        appChargerIsConnected() != CHARGER_DISCONNECTED)
+    {
+        battery->adaptive_period = battery->period;
+        battery->stable_readings = 0;
+    }
+    else if (++battery->stable_readings >= BATTERY_FILTER_LEN)
+    {
+        battery->adaptive_period = (uint16)MIN((uint32)battery->adaptive_period * 2, max_period);
+        battery->stable_readings = 0;
+    }
+}
+
 static void appBatteryScheduleNextMeasurement(batteryTaskData *battery)
 {
     uint32 delay = FILTER_IS_FULL(battery) ?
-                        battery->period :
+                        MAX(battery->adaptive_period, battery->period) :
                         BATTERY_READ_PERIOD_INITIAL;
     MessageSendLater(&battery->task, MESSAGE_BATTERY_INTERNAL_MEASUREMENT_TRIGGER,
                         NULL, delay);
 }
 
+/*! A charger connected: the voltage is about to move, so go back to the base
+    period now rather than after the next reading, which may be up to
+    appConfigBatteryReadPeriodMaxMs() away. */
+static void appBatteryHandleChargerAttached(batteryTaskData *battery)
+{
+    bool backed_off = (battery->adaptive_period > battery->period);
+
+    battery->adaptive_period = battery->period;
+    battery->stable_readings = 0;
+
+    /* While the filter is filling readings are already back to back */
+    if (backed_off && FILTER_IS_FULL(battery) &&
+        MessageCancelAll(&battery->task, MESSAGE_BATTERY_INTERNAL_MEASUREMENT_TRIGGER))
+    {
+        appBatteryScheduleNextMeasurement(battery);
+    }
+}
+
 /*! Return TRUE if a new voltage is available,with enough samples that the result
     should be stable. This waits for the filter to be full. */
 static bool appBatteryAdcResultHandler(batteryTaskData *battery, MessageAdcResult* result)
@@ -289,6 +344,10 @@ static bool appBatteryAdcResultHandler(batteryTaskData *battery, MessageAdcResul
             {
                 battery->filter.index = BATTERY_FILTER_LEN;
             }
+            if (FILTER_IS_FULL(battery))
+            {
+                appBatteryAdaptPeriod(battery, vbatt_mv);
+            }
             appBatteryScheduleNextMeasurement(battery);
             return FILTER_IS_FULL(battery);
         }
@@ -328,6 +387,16 @@ static void appBatteryHandleMessage(Task task, MessageId id, Message message)
                 AdcReadRequest(&battery->task, adcsel_pmu_vbat_sns, 0, 0);
                 break;
 
+            case CHARGER_MESSAGE_ATTACHED:
+                appBatteryHandleChargerAttached(battery);
+                break;
+
+            case CHARGER_MESSAGE_DETACHED:
+            case CHARGER_MESSAGE_COMPLETED:
+            case CHARGER_MESSAGE_CHARGING_OK:
+            case CHARGER_MESSAGE_CHARGING_LOW:
+                break;
+
             default:
                 /* An unexpected message has arrived - must handle it */
                 appHandleUnexpected(id);
@@ -345,6 +414,7 @@ bool appBatteryInit(Task init_task)
     /* Set up task handler */
     battery->task.handler = appBatteryHandleMessage;
     battery->period = appConfigBatteryReadPeriodMs();
+    battery->adaptive_period = battery->period;
 
     appBatteryScheduleNextMeasurement(battery);
 
@@ -352,10 +422,19 @@ bool appBatteryInit(Task init_task)
     return TRUE;
 }
 
+bool appBatteryRegisterChargerClient(Task init_task)
+{
+    UNUSED(init_task);
+    (void)appChargerClientRegister(&GetBattery()->task);
+    return TRUE;
+}
+
 void appBatterySetPeriod(uint16 period)
 {
     batteryTaskData *battery = GetBattery();
     DEBUG_LOGF("appBatteryMonPeriod %d", period);
+    battery->adaptive_period = period;
+    battery->stable_readings = 0;
     if (period == 0)
     {
         /* Reset the filter data */
@@ -121,8 +121,13 @@ typedef struct
 {
     /*! Battery task */
     TaskData task;
-    /*! The measurement period */
+    /*! The base measurement period */
     uint16 period;
+    /*! The current measurement period, between period and
+        appConfigBatteryReadPeriodMaxMs() */
+    uint16 adaptive_period;
+    /*! Number of stable readings taken at adaptive_period */
+    uint16 stable_readings;
     /*! Store the vref measurement, which is required to calculate vbat */
     uint16 vref_raw;
     /*! A sub-struct to allow reset */
@@ -147,6 +152,17 @@ extern batteryTaskData app_battery;
 /*! Start monitoring the battery voltage */
 bool appBatteryInit(Task init_task);
 
+/*! \brief Register the battery monitor for charger notifications.
+
+    Connecting a charger then drops the measurement period back to the base
+    period straight away. Call after appChargerInit(), which resets the
+    charger client list.
+
+    \param init_task Unused.
+    \return TRUE
+*/
+bool appBatteryRegisterChargerClient(Task init_task);
+
 /*! @brief Override the default measurement period.
     @param period The measurement period in milli-seconds.
     Setting to zero stops and resets the monitor, the monitor remains stopped
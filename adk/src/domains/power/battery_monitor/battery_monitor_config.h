@@ -27,6 +27,19 @@
 /*! The interval at which the battery voltage is read. */
 #define appConfigBatteryReadPeriodMs() D_SEC(2)
 
+/*! The longest interval the read period backs off to while the battery
+    voltage is stable and no charger is connected. */
+#define appConfigBatteryReadPeriodMaxMs() D_SEC(16)
+
+/*! A reading further than this from the filtered voltage means the battery
+    load has changed, and the read period drops back to the base period.
+    Units of milli-volts */
+#define appConfigBatteryStableMarginMv() (20)
+
+/*! Filtered voltages within this margin of a level threshold are always
+    read at the base period. Units of milli-volts */
+#define appConfigBatteryThresholdMarginMv() (50)
+
 /*! Margin to apply on battery readings before accepting that
     the level has changed. Units of milli-volts */
 #define appConfigSmBatteryHysteresisMargin() (50)
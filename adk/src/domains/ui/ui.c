@@ -78,6 +78,14 @@ static uint8 num_of_ctxt_consumers = 0;
 static const ui_config_table_content_t* ui_config_table;
 static unsigned ui_config_size = 0;
 
+/*! Rows of the config table sorted by logical input. Rows for the same
+    logical input stay in table order, so the first match still wins. */
+static uint16 *ui_config_index = NULL;
+
+/*! Index in registered_ui_providers of the provider for each config table
+    row, or ERROR_UI_PROVIDER_NOT_PRESENT */
+static uint8 *ui_config_provider_index = NULL;
+
 /*! The default UI interceptor function */
 inject_ui_input inject_ui_input_funcptr = NULL;
 
@@ -95,29 +103,85 @@ static uint8 getUiProviderIndexInRegisteredList(ui_providers_t ui_provider_id)
     return ERROR_UI_PROVIDER_NOT_PRESENT;
 }
 
+static void ui_ResolveConfigTableProviders(void)
+{
+    for(unsigned row = 0; row < ui_config_size; row++)
+    {
+        ui_config_provider_index[row] = getUiProviderIndexInRegisteredList(ui_config_table[row].ui_provider_id);
+    }
+}
+
+static void ui_BuildConfigTableIndex(void)
+{
+    free(ui_config_index);
+    free(ui_config_provider_index);
+    ui_config_index = NULL;
+    ui_config_provider_index = NULL;
+
+    if(!ui_config_size)
+        return;
+
+    ui_config_index = PanicUnlessMalloc(ui_config_size * sizeof(*ui_config_index));
+    ui_config_provider_index = PanicUnlessMalloc(ui_config_size * sizeof(*ui_config_provider_index));
+
+    /* Insertion sort, which is stable so rows keep their table order */
+    for(unsigned row = 0; row < ui_config_size; row++)
+    {
+        unsigned position = row;
+
+        while(position && ui_config_table[ui_config_index[position - 1]].logical_input > ui_config_table[row].logical_input)
+        {
+            ui_config_index[position] = ui_config_index[position - 1];
+            position--;
+        }
+        ui_config_index[position] = row;
+    }
+
+    ui_ResolveConfigTableProviders();
+}
+
+static unsigned ui_FindFirstConfigTableEntry(unsigned logical_input)
+{
+    unsigned low = 0;
+    unsigned high = ui_config_size;
+
+    while(low < high)
+    {
+        unsigned mid = (low + high) / 2;
+
+        if(ui_config_table[ui_config_index[mid]].logical_input < logical_input)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
 static ui_input_t getUiInput(unsigned logical_input)
 {
-    uint8 ui_provider_index_in_list = 0;
+    uint8 ui_provider_index_in_list = ERROR_UI_PROVIDER_NOT_PRESENT;
     unsigned ui_provider_ctxt = 0;
 
-    for(uint8 index = 0; index < ui_config_size; index++)
+    for(unsigned entry = ui_FindFirstConfigTableEntry(logical_input); entry < ui_config_size; entry++)
     {
-        if(ui_config_table[index].logical_input == logical_input)
-        {
-            /* find index of the ui provider registered for the logical input in the list*/
-            ui_provider_index_in_list = getUiProviderIndexInRegisteredList(ui_config_table[index].ui_provider_id );
+        unsigned row = ui_config_index[entry];
 
-            if(ui_provider_index_in_list != ERROR_UI_PROVIDER_NOT_PRESENT)
-            {
-                /* get current context of this ui provider*/
-                ui_provider_ctxt = registered_ui_providers[ui_provider_index_in_list].ui_provider_context_callback();
+        if(ui_config_table[row].logical_input != logical_input)
+            break;
 
-                /* if context is same then return corresponding ui input*/
-                if(ui_provider_ctxt == ui_config_table[index].ui_provider_context)
-                    return ui_config_table[index].ui_input;
+        if(ui_config_provider_index[row] == ERROR_UI_PROVIDER_NOT_PRESENT)
+            continue;
 
-            }
+        /* get current context of this ui provider, once per provider for consecutive rows */
+        if(ui_config_provider_index[row] != ui_provider_index_in_list)
+        {
+            ui_provider_index_in_list = ui_config_provider_index[row];
+            ui_provider_ctxt = registered_ui_providers[ui_provider_index_in_list].ui_provider_context_callback();
         }
+
+        /* if context is same then return corresponding ui input*/
+        if(ui_provider_ctxt == ui_config_table[row].ui_provider_context)
+            return ui_config_table[row].ui_input;
     }
     return ui_input_invalid;
 }
@@ -233,6 +297,8 @@ void Ui_RegisterUiProvider(ui_providers_t ui_provider, ui_provider_context_callb
     new_provider->ui_provider_id = ui_provider;
 
     num_of_ui_providers++;
+
+    ui_ResolveConfigTableProviders();
 }
 
 void Ui_UnregisterUiProviders(void)
@@ -240,6 +306,8 @@ void Ui_UnregisterUiProviders(void)
     free(registered_ui_providers);
     registered_ui_providers = NULL;
     num_of_ui_providers = 0;
+
+    ui_ResolveConfigTableProviders();
 }
 
 void Ui_RegisterUiInputConsumer(Task ui_input_consumer_task,
@@ -329,6 +397,8 @@ void Ui_SetConfigurationTable(const ui_config_table_content_t* config_table,
 {
     ui_config_table = config_table;
     ui_config_size = config_size;
+
+    ui_BuildConfigTableIndex();
 }
 
 void Ui_RegisterUiInputsMessageGroup(Task task, message_group_t group)
@@ -16,38 +16,98 @@
 #include "prompts.h"
 #include "domain_message.h"
 
+#include <stdlib.h>
+#include <panic.h>
+
 ui_promptsTaskData  ui_prompts;
 
 #define ERROR_MESSAGE_ID_NOT_PRESENT 0xFF
 
-static uint8 uiPrompts_GetMessageIdIndexFromList(MessageId id)
+/*! Rows of ui_prompts_config_table sorted by System Event. Rows for the same
+    System Event stay in table order, so the first row still wins. */
+static uint8 *ui_prompts_sys_event_index = NULL;
+
+static void uiPrompts_BuildSysEventIndex(void)
 {
-    uint8 index = ERROR_MESSAGE_ID_NOT_PRESENT;
-    uint8 i = 0;
-    for(i = 0 ; i < UiPrompts_GetConfigTableSize(); i++)
+    uint8 table_size = UiPrompts_GetConfigTableSize();
+
+    PanicFalse(UiPrompts_GetConfigTableSize() < ERROR_MESSAGE_ID_NOT_PRESENT);
+
+    free(ui_prompts_sys_event_index);
+    ui_prompts_sys_event_index = NULL;
+
+    if(!table_size)
+        return;
+
+    ui_prompts_sys_event_index = PanicUnlessMalloc(table_size * sizeof(*ui_prompts_sys_event_index));
+
+    /* Insertion sort, which is stable so rows keep their table order */
+    for(uint8 row = 0; row < table_size; row++)
     {
-        if(id == ui_prompts_config_table[i].sys_event)
+        uint8 position = row;
+
+        while(position && ui_prompts_config_table[ui_prompts_sys_event_index[position - 1]].sys_event > ui_prompts_config_table[row].sys_event)
         {
-            return i;
+            ui_prompts_sys_event_index[position] = ui_prompts_sys_event_index[position - 1];
+            position--;
         }
+        ui_prompts_sys_event_index[position] = row;
+    }
+}
+
+static uint8 uiPrompts_GetMessageIdIndexFromList(MessageId id)
+{
+    uint8 low = 0;
+    uint8 high = UiPrompts_GetConfigTableSize();
+
+    if(!ui_prompts_sys_event_index)
+        return ERROR_MESSAGE_ID_NOT_PRESENT;
+
+    while(low < high)
+    {
+        uint8 mid = (low + high) / 2;
+
+        if(ui_prompts_config_table[ui_prompts_sys_event_index[mid]].sys_event < id)
+            low = mid + 1;
+        else
+            high = mid;
     }
-    return index;
+
+    if(low < UiPrompts_GetConfigTableSize() && ui_prompts_config_table[ui_prompts_sys_event_index[low]].sys_event == id)
+        return ui_prompts_sys_event_index[low];
+
+    return ERROR_MESSAGE_ID_NOT_PRESENT;
 }
 
 static void uiPrompts_UpdateMessageGroupsToSniff(void)
 {
-    uint8 index = 0;
+    uint8 table_size = UiPrompts_GetConfigTableSize();
+    message_group_t *groups;
+    unsigned num_groups = 0;
+
+    if(!table_size)
+        return;
 
-    for(index = 0 ; index < UiPrompts_GetConfigTableSize(); index++)
+    groups = PanicUnlessMalloc(table_size * sizeof(*groups));
+
+    /* Rows are visited in System Event order, so rows in the same group are adjacent */
+    for(uint8 index = 0 ; index < table_size; index++)
     {
-        MessageId sys_event = ui_prompts_config_table[index].sys_event;
+        MessageId sys_event = ui_prompts_config_table[ui_prompts_sys_event_index[index]].sys_event;
         message_group_t group = ID_TO_MSG_GRP(sys_event);
 
-        MessageBroker_RegisterInterestInMsgGroups(
-            UiPrompts_GetUiPromptsTask(),
-            &group,
-            1);      
-    }    
+        if(!num_groups || groups[num_groups - 1] != group)
+        {
+            groups[num_groups++] = group;
+        }
+    }
+
+    if(num_groups)
+    {
+        MessageBroker_RegisterInterestInMsgGroups(UiPrompts_GetUiPromptsTask(), groups, num_groups);
+    }
+
+    free(groups);
 }
  
 static void uiPrompts_HandleMessage(Task task, MessageId id, Message message)
@@ -86,6 +146,7 @@ bool UiPrompts_Init(Task init_task)
     theTaskData->process_events = TRUE;
     
     /* Add the MessageGroup using the ui_prompts_config_table table*/
+    uiPrompts_BuildSysEventIndex();
     uiPrompts_UpdateMessageGroupsToSniff();
 
    /* this module ultimately play the prompts, will be moved to earbud_init*/
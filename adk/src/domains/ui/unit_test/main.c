@@ -0,0 +1,22 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      UI input path trace replay harness, built for the host with
+            DESKTOP_TEST_BUILD, see the Makefile.
+*/
+
+#include <stdio.h>
+#include "unity.h"
+#include "test_ui_trace.h"
+
+
+/* UI input path trace replay harness */
+int main (void)
+{
+    /* Test runner for test_ui_trace.c */
+    test_ui_trace();
+
+    return unity_failures ? 1 : 0;
+}
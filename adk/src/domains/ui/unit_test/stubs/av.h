@@ -0,0 +1,13 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for av.h, nothing from it is used by
+            ui_prompts.c beyond the message groups in domain_message.h.
+*/
+
+#ifndef AV_H_
+#define AV_H_
+
+#endif /* AV_H_ */
@@ -0,0 +1,13 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for bt_device.h, nothing from it is used on
+            the UI input path.
+*/
+
+#ifndef BT_DEVICE_H_
+#define BT_DEVICE_H_
+
+#endif /* BT_DEVICE_H_ */
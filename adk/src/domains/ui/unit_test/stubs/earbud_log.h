@@ -0,0 +1,13 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for earbud_log.h, logging is disabled in the
+            host build.
+*/
+
+#ifndef EARBUD_LOG_H_
+#define EARBUD_LOG_H_
+
+#endif /* EARBUD_LOG_H_ */
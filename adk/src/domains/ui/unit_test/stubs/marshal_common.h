@@ -0,0 +1,15 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for marshal_common.h, without the stream types
+            that need the firmware's Sink definitions.
+*/
+
+#ifndef MARSHAL_COMMON_H_
+#define MARSHAL_COMMON_H_
+
+#include <marshal.h>
+
+#endif /* MARSHAL_COMMON_H_ */
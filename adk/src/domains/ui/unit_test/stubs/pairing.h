@@ -0,0 +1,13 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for pairing.h, nothing from it is used by
+            ui_prompts.c beyond the message groups in domain_message.h.
+*/
+
+#ifndef PAIRING_H_
+#define PAIRING_H_
+
+#endif /* PAIRING_H_ */
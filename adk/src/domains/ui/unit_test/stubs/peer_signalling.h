@@ -0,0 +1,45 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for peer_signalling.h: the marshalled message
+            channel used by the logical input switch. The test provides the
+            functions.
+*/
+
+#ifndef PEER_SIGNALLING_H_
+#define PEER_SIGNALLING_H_
+
+#include <marshal.h>
+#include <domain_message.h>
+
+typedef enum
+{
+    PEER_SIG_MSG_CHANNEL_LOGICAL_INPUT_SWITCH = 1
+} peerSigMsgChannel;
+
+enum
+{
+    PEER_SIG_MARSHALLED_MSG_CHANNEL_RX_IND = PEER_SIG_MESSAGE_BASE,
+    PEER_SIG_MARSHALLED_MSG_CHANNEL_TX_CFM
+};
+
+typedef struct
+{
+    void *msg;
+} PEER_SIG_MARSHALLED_MSG_CHANNEL_RX_IND_T;
+
+typedef struct
+{
+    int status;
+} PEER_SIG_MARSHALLED_MSG_CHANNEL_TX_CFM_T;
+
+void appPeerSigMarshalledMsgChannelTaskRegister(Task task, peerSigMsgChannel channel,
+                                                const marshal_type_descriptor_t * const * type_desc,
+                                                size_t num_type_desc);
+
+void appPeerSigMarshalledMsgChannelTx(Task task, peerSigMsgChannel channel,
+                                      void* msg, marshal_type_t type);
+
+#endif /* PEER_SIGNALLING_H_ */
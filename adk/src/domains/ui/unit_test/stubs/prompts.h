@@ -0,0 +1,15 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for prompts.h, which pulls in the whole of
+            kymera. ui_prompts.c only calls Prompts_Init().
+*/
+
+#ifndef PROMPTS_H_
+#define PROMPTS_H_
+
+void Prompts_Init(void);
+
+#endif /* PROMPTS_H_ */
@@ -0,0 +1,13 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host build stand-in for state_proxy.h, nothing from it is used on
+            the UI input path.
+*/
+
+#ifndef STATE_PROXY_H_
+#define STATE_PROXY_H_
+
+#endif /* STATE_PROXY_H_ */
@@ -0,0 +1,255 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the System Event lookup and message group registration
+            of ui_prompts.c, run against a test config table.
+*/
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hydra_macros.h>
+#include <panic.h>
+
+#include <message_broker.h>
+#include <ui.h>
+
+#include "ui_prompts.h"
+#include "ui_prompts_config_table.h"
+#include "prompts.h"
+#include "test_ui_prompts.h"
+
+/*! No UI input was injected */
+#define NO_UI_INPUT     ((ui_input_t)0)
+
+/*! Most message groups registered in one call */
+#define MAX_GROUPS      (8)
+
+/*! The test config table. It isn't sorted, groups are interleaved and two
+    System Events have more than one row, of which the first should win. */
+const ui_prompts_config_table_t ui_prompts_config_table[] =
+{
+    { TELEPHONY_MESSAGE_BASE + 1,   ui_input_prompt_connected           },
+    { PAIRING_MESSAGE_BASE + 2,     ui_input_prompt_pairing_successful  },
+    { AV_MESSAGE_BASE + 5,          ui_input_prompt_disconnected        },
+    { PAIRING_MESSAGE_BASE,         ui_input_prompt_pairing             },
+    { TELEPHONY_MESSAGE_BASE + 1,   ui_input_prompt_disconnected        },
+    { AV_MESSAGE_BASE + 1,          ui_input_prompt_connected           },
+    { PAIRING_MESSAGE_BASE + 3,     ui_input_prompt_pairing_failed      },
+    { PAIRING_MESSAGE_BASE + 2,     ui_input_prompt_pairing_failed      },
+};
+
+/*! The message groups used by the test config table */
+static const message_group_t table_groups[] = {AV_MESSAGE_GROUP, PAIRING_MESSAGE_GROUP, TELEPHONY_MESSAGE_GROUP};
+
+static struct
+{
+    /*! Rows of the test config table in use */
+    unsigned table_size;
+    /*! Calls to MessageBroker_RegisterInterestInMsgGroups */
+    unsigned registrations;
+    Task registered_task;
+    message_group_t groups[MAX_GROUPS];
+    unsigned num_groups;
+    /*! UI inputs injected */
+    unsigned ui_inputs;
+    ui_input_t last_ui_input;
+} fake;
+
+/******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static void testUiPrompts_Init(unsigned table_size)
+{
+    fake.table_size = table_size;
+    fake.registrations = 0;
+    fake.num_groups = 0;
+    UiPrompts_Init(NULL);
+}
+
+/*! Send a System Event to ui_prompts and return the UI input it injected */
+static ui_input_t testUiPrompts_SysEvent(MessageId id)
+{
+    Task task = UiPrompts_GetUiPromptsTask();
+
+    fake.last_ui_input = NO_UI_INPUT;
+    task->handler(task, id, NULL);
+    return fake.last_ui_input;
+}
+
+/*! The UI input for a System Event from the first matching table row */
+static ui_input_t testUiPrompts_ScanTable(MessageId id)
+{
+    for (unsigned row = 0; row < fake.table_size; row++)
+    {
+        if (ui_prompts_config_table[row].sys_event == id)
+            return ui_prompts_config_table[row].ui_input;
+    }
+    return NO_UI_INPUT;
+}
+
+static bool testUiPrompts_GroupRegistered(message_group_t group)
+{
+    for (unsigned i = 0; i < fake.num_groups; i++)
+    {
+        if (fake.groups[i] == group)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/******************************************************************************
+ * Tests
+ ******************************************************************************/
+void setUp(void)
+{
+    memset(&fake, 0, sizeof(fake));
+}
+
+void tearDown(void)
+{
+}
+
+static void test_LookupMatchesTableScan(void)
+{
+    /* Every leading part of the table, down to none of it */
+    for (unsigned table_size = 0; table_size <= ARRAY_DIM(ui_prompts_config_table); table_size++)
+    {
+        testUiPrompts_Init(table_size);
+
+        for (unsigned g = 0; g < ARRAY_DIM(table_groups); g++)
+        {
+            for (MessageId id = MSG_GRP_TO_ID(table_groups[g]); id <= LAST_ID_IN_MSG_GRP(table_groups[g]); id++)
+            {
+                TEST_ASSERT_EQUAL(testUiPrompts_ScanTable(id), testUiPrompts_SysEvent(id));
+            }
+        }
+        TEST_ASSERT_EQUAL(NO_UI_INPUT, testUiPrompts_SysEvent(0));
+        TEST_ASSERT_EQUAL(NO_UI_INPUT, testUiPrompts_SysEvent(0xffff));
+    }
+}
+
+static void test_FirstRowWins(void)
+{
+    testUiPrompts_Init(ARRAY_DIM(ui_prompts_config_table));
+
+    TEST_ASSERT_EQUAL(ui_input_prompt_connected, testUiPrompts_SysEvent(TELEPHONY_MESSAGE_BASE + 1));
+    TEST_ASSERT_EQUAL(ui_input_prompt_pairing_successful, testUiPrompts_SysEvent(PAIRING_MESSAGE_BASE + 2));
+    TEST_ASSERT_EQUAL(ui_input_prompt_pairing, testUiPrompts_SysEvent(PAIRING_MESSAGE_BASE));
+    TEST_ASSERT_EQUAL(NO_UI_INPUT, testUiPrompts_SysEvent(PAIRING_MESSAGE_BASE + 1));
+}
+
+static void test_EachGroupRegisteredOnce(void)
+{
+    testUiPrompts_Init(ARRAY_DIM(ui_prompts_config_table));
+
+    TEST_ASSERT_EQUAL(1, fake.registrations);
+    TEST_ASSERT(fake.registered_task == UiPrompts_GetUiPromptsTask());
+    TEST_ASSERT_EQUAL(ARRAY_DIM(table_groups), fake.num_groups);
+    for (unsigned g = 0; g < ARRAY_DIM(table_groups); g++)
+    {
+        TEST_ASSERT(testUiPrompts_GroupRegistered(table_groups[g]));
+    }
+
+    /* Only the telephony and pairing rows */
+    testUiPrompts_Init(2);
+    TEST_ASSERT_EQUAL(1, fake.registrations);
+    TEST_ASSERT_EQUAL(2, fake.num_groups);
+    TEST_ASSERT(!testUiPrompts_GroupRegistered(AV_MESSAGE_GROUP));
+}
+
+static void test_EmptyTable(void)
+{
+    testUiPrompts_Init(0);
+
+    TEST_ASSERT_EQUAL(0, fake.registrations);
+    TEST_ASSERT_EQUAL(NO_UI_INPUT, testUiPrompts_SysEvent(PAIRING_MESSAGE_BASE));
+    TEST_ASSERT_EQUAL(0, fake.ui_inputs);
+
+    /* A table after an empty one is indexed again */
+    testUiPrompts_Init(ARRAY_DIM(ui_prompts_config_table));
+    TEST_ASSERT_EQUAL(ui_input_prompt_pairing, testUiPrompts_SysEvent(PAIRING_MESSAGE_BASE));
+}
+
+static void test_ProcessEventsOff(void)
+{
+    testUiPrompts_Init(ARRAY_DIM(ui_prompts_config_table));
+
+    UiPrompts_ProcessEvents(FALSE);
+    TEST_ASSERT_EQUAL(NO_UI_INPUT, testUiPrompts_SysEvent(PAIRING_MESSAGE_BASE));
+    TEST_ASSERT_EQUAL(0, fake.ui_inputs);
+
+    UiPrompts_ProcessEvents(TRUE);
+    TEST_ASSERT_EQUAL(ui_input_prompt_pairing, testUiPrompts_SysEvent(PAIRING_MESSAGE_BASE));
+    TEST_ASSERT_EQUAL(1, fake.ui_inputs);
+}
+
+void test_ui_prompts(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_LookupMatchesTableScan);
+    RUN_TEST(test_FirstRowWins);
+    RUN_TEST(test_EachGroupRegisteredOnce);
+    RUN_TEST(test_EmptyTable);
+    RUN_TEST(test_ProcessEventsOff);
+
+    UNITY_END();
+}
+
+/******************************************************************************
+ * Fakes
+ ******************************************************************************/
+unsigned UiPrompts_GetConfigTableSize(void)
+{
+    return fake.table_size;
+}
+
+void MessageBroker_RegisterInterestInMsgGroups(Task task, const message_group_t* msg_groups, unsigned num_groups)
+{
+    if (num_groups > MAX_GROUPS)
+        Panic();
+
+    fake.registrations++;
+    fake.registered_task = task;
+    memcpy(fake.groups, msg_groups, num_groups * sizeof(*msg_groups));
+    fake.num_groups = num_groups;
+}
+
+void Ui_InjectUiInput(ui_input_t ui_input)
+{
+    fake.ui_inputs++;
+    fake.last_ui_input = ui_input;
+}
+
+void Prompts_Init(void)
+{
+}
+
+void Panic(void)
+{
+    printf("PANIC\n");
+    abort();
+}
+
+void *PanicNull(void *pointer)
+{
+    if (pointer == NULL)
+        Panic();
+    return pointer;
+}
+
+void PanicNotNull(const void *pointer)
+{
+    if (pointer != NULL)
+        Panic();
+}
+
+/*! The firmware heap has no zero size blocks, so neither does the fake */
+void *PanicUnlessMalloc(size_t size)
+{
+    return PanicNull(size ? malloc(size) : NULL);
+}
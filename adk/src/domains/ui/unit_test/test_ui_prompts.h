@@ -0,0 +1,20 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the System Event lookup of ui_prompts.c.
+*/
+
+#ifndef TEST_UI_PROMPTS_H_
+#define TEST_UI_PROMPTS_H_
+
+/*! \brief Test runner for ui_prompts.c.
+
+    Initialises ui_prompts with parts of a test config table, checks every
+    System Event in its message groups against a scan of the table and
+    checks each message group is registered once.
+*/
+void test_ui_prompts(void);
+
+#endif /* TEST_UI_PROMPTS_H_ */
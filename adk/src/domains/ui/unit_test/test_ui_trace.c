@@ -0,0 +1,360 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Recorded button gestures replayed through the input event manager,
+            logical input switch and ui modules, checked against golden outputs.
+*/
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hydra_macros.h>
+#include <panic.h>
+
+#include <input_event_manager.h>
+#include <logical_input_switch.h>
+#include <peer_signalling.h>
+#include <ui.h>
+
+#include "test_ui_trace.h"
+#include "ui_trace_replay.h"
+
+/*! The button under test, on PIO 4 and mapped to input event bit 0 */
+#define BUTTON_PIO              (4)
+#define BUTTON_INPUT_EVENT      (1UL << 0)
+
+#define BUTTON_DEBOUNCE_READS   (4)
+#define BUTTON_DEBOUNCE_PERIOD  (5)
+
+/*! Time to run on after a gesture, long enough for every timer to expire */
+#define GESTURE_SETTLE_MS       (2000)
+
+#define LI_BUTTON_SINGLE_CLICK  (LOGICAL_INPUT_MESSAGE_BASE + 0)
+#define LI_BUTTON_DOUBLE_CLICK  (LOGICAL_INPUT_MESSAGE_BASE + 1)
+#define LI_BUTTON_HELD_1S       (LOGICAL_INPUT_MESSAGE_BASE + 2)
+#define LI_BUTTON_HELD_RELEASE  (LOGICAL_INPUT_MESSAGE_BASE + 3)
+
+/*! Maximum number of UI inputs kept for the latency report */
+#define MAX_LATENCIES           (32)
+
+/*! A UI input expected from a gesture, with its latency from the first
+    press edge */
+typedef struct
+{
+    uint32 latency;
+    ui_input_t ui_input;
+} expected_ui_input_t;
+
+/*! A recorded gesture and its golden output */
+typedef struct
+{
+    const char *name;
+    const ui_trace_edge_t *edges;
+    unsigned num_edges;
+    const expected_ui_input_t *ui_inputs;
+    unsigned num_ui_inputs;
+    /* Messages delivered to each stage of the input path */
+    unsigned pio_changed_messages;
+    unsigned iem_timer_messages;
+    unsigned logical_inputs;
+    /* Heap allocations made while replaying the gesture */
+    unsigned heap_allocations;
+} gesture_t;
+
+static const InputActionMessage_t button_actions[] =
+{
+    { BUTTON_INPUT_EVENT, BUTTON_INPUT_EVENT, SINGLE_CLICK, 0, 0, LI_BUTTON_SINGLE_CLICK },
+    { BUTTON_INPUT_EVENT, BUTTON_INPUT_EVENT, DOUBLE_CLICK, 0, 0, LI_BUTTON_DOUBLE_CLICK },
+    { BUTTON_INPUT_EVENT, BUTTON_INPUT_EVENT, HELD, 1000, 0, LI_BUTTON_HELD_1S },
+    { BUTTON_INPUT_EVENT, BUTTON_INPUT_EVENT, HELD_RELEASE, 3000, 0, LI_BUTTON_HELD_RELEASE },
+};
+
+static const ui_config_table_content_t button_ui_config[] =
+{
+    { LI_BUTTON_SINGLE_CLICK, ui_provider_media_player, 0, ui_input_toggle_play_pause },
+    { LI_BUTTON_DOUBLE_CLICK, ui_provider_media_player, 0, ui_input_av_forward },
+    { LI_BUTTON_HELD_1S,      ui_provider_media_player, 0, ui_input_button_held_1 },
+    { LI_BUTTON_HELD_RELEASE, ui_provider_media_player, 0, ui_input_sm_pair_handset },
+};
+
+static InputEventConfig_t button_config;
+
+/*! Press and release, with contact bounce on both edges */
+static const ui_trace_edge_t single_click_edges[] =
+{
+    {   0, BUTTON_PIO, TRUE  },
+    {   2, BUTTON_PIO, FALSE },
+    {   3, BUTTON_PIO, TRUE  },
+    { 180, BUTTON_PIO, FALSE },
+    { 183, BUTTON_PIO, TRUE  },
+    { 185, BUTTON_PIO, FALSE },
+};
+
+static const ui_trace_edge_t double_click_edges[] =
+{
+    {   0, BUTTON_PIO, TRUE  },
+    {   3, BUTTON_PIO, FALSE },
+    {   4, BUTTON_PIO, TRUE  },
+    { 150, BUTTON_PIO, FALSE },
+    { 310, BUTTON_PIO, TRUE  },
+    { 312, BUTTON_PIO, FALSE },
+    { 314, BUTTON_PIO, TRUE  },
+    { 460, BUTTON_PIO, FALSE },
+};
+
+static const ui_trace_edge_t held_edges[] =
+{
+    {    0, BUTTON_PIO, TRUE  },
+    {    2, BUTTON_PIO, FALSE },
+    {    4, BUTTON_PIO, TRUE  },
+    { 1600, BUTTON_PIO, FALSE },
+};
+
+static const ui_trace_edge_t held_release_edges[] =
+{
+    {    0, BUTTON_PIO, TRUE  },
+    { 3400, BUTTON_PIO, FALSE },
+    { 3401, BUTTON_PIO, TRUE  },
+    { 3403, BUTTON_PIO, FALSE },
+};
+
+static const expected_ui_input_t single_click_ui_inputs[] =
+{
+    {  705, ui_input_toggle_play_pause },
+};
+
+static const expected_ui_input_t double_click_ui_inputs[] =
+{
+    {  480, ui_input_av_forward },
+};
+
+static const expected_ui_input_t held_ui_inputs[] =
+{
+    { 1024, ui_input_button_held_1 },
+};
+
+static const expected_ui_input_t held_release_ui_inputs[] =
+{
+    { 1020, ui_input_button_held_1 },
+    { 3423, ui_input_sm_pair_handset },
+};
+
+#define GESTURE(name, pio_changed, iem_timers, logical_inputs, allocations) \
+    { #name, name##_edges, ARRAY_DIM(name##_edges), name##_ui_inputs, ARRAY_DIM(name##_ui_inputs), \
+      pio_changed, iem_timers, logical_inputs, allocations }
+
+static const gesture_t gestures[] =
+{
+    GESTURE(single_click, 2, 2, 1, 7),
+    GESTURE(double_click, 4, 1, 1, 11),
+    GESTURE(held,         2, 1, 1, 5),
+    GESTURE(held_release, 2, 2, 2, 6),
+};
+
+static void testUiTrace_HandleUiInput(Task task, MessageId id, Message message);
+
+static TaskData ui_input_consumer = { testUiTrace_HandleUiInput };
+static Task iem_task;
+
+static uint32 latencies[MAX_LATENCIES];
+static unsigned num_latencies;
+
+static void testUiTrace_HandleUiInput(Task task, MessageId id, Message message)
+{
+    /* UI inputs are picked up from the replay records */
+    UNUSED(task);
+    UNUSED(id);
+    UNUSED(message);
+}
+
+static unsigned testMediaPlayerContext(void)
+{
+    return 0;
+}
+
+/* Peer signalling is not part of the replay, logical inputs are never
+   rerouted to the peer */
+void appPeerSigMarshalledMsgChannelTaskRegister(Task task, peerSigMsgChannel channel,
+                                                const marshal_type_descriptor_t * const * type_desc,
+                                                size_t num_type_desc)
+{
+    UNUSED(task);
+    UNUSED(channel);
+    UNUSED(type_desc);
+    UNUSED(num_type_desc);
+}
+
+void appPeerSigMarshalledMsgChannelTx(Task task, peerSigMsgChannel channel,
+                                      void* msg, marshal_type_t type)
+{
+    UNUSED(task);
+    UNUSED(channel);
+    UNUSED(msg);
+    UNUSED(type);
+    Panic();
+}
+
+/* The message broker registers UI input consumers with the ui module */
+void MessageBroker_RegisterInterestInMsgGroups(Task task, const message_group_t* msg_groups, unsigned num_groups)
+{
+    for (unsigned i = 0; i < num_groups; i++)
+        Ui_RegisterUiInputsMessageGroup(task, msg_groups[i]);
+}
+
+/* Called by RUN_TEST macro before actual test function is invoked */
+static void setUp(void)
+{
+    UiTraceReplay_ClearRecords();
+}
+
+/* Called by RUN_TEST macro after actual test function has completed */
+static void tearDown(void)
+{
+}
+
+static void testUiTrace_Setup(void)
+{
+    static const message_group_t ui_input_groups[] =
+    {
+        UI_INPUTS_MEDIA_PLAYER_MESSAGE_GROUP,
+        UI_INPUTS_TONE_FEEDBACK_MESSAGE_GROUP,
+        UI_INPUTS_HANDSET_MESSAGE_GROUP,
+    };
+
+    memset(button_config.pio_mapping, 0, sizeof(button_config.pio_mapping));
+    button_config.pio_config[BUTTON_PIO / 32] = 1UL << (BUTTON_PIO % 32);
+    button_config.debounce_reads = BUTTON_DEBOUNCE_READS;
+    button_config.debounce_period = BUTTON_DEBOUNCE_PERIOD;
+
+    Ui_Init(NULL);
+    Ui_SetConfigurationTable(button_ui_config, ARRAY_DIM(button_ui_config));
+    Ui_RegisterUiProvider(ui_provider_media_player, testMediaPlayerContext);
+    Ui_RegisterUiInputConsumer(&ui_input_consumer, ui_input_groups, ARRAY_DIM(ui_input_groups));
+    LogicalInputSwitch_Init(NULL);
+
+    iem_task = InputEventManagerInit(LogicalInputSwitch_GetTask(), button_actions,
+                                     sizeof(button_actions), &button_config);
+    InputEventManagerEnable();
+    UiTraceReplay_RunUntil(UiTraceReplay_GetTime());
+}
+
+static unsigned testUiTrace_CountPioChanged(const ui_trace_record_t *records, unsigned num_records)
+{
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < num_records; i++)
+    {
+        if (records[i].task == iem_task && records[i].id == MESSAGE_PIO_CHANGED)
+            count++;
+    }
+    return count;
+}
+
+/*! Replay a gesture, check it against its golden output and print the
+    message counts, heap use and latency of each UI input */
+static void testUiTrace_Gesture(const gesture_t *gesture)
+{
+    const uint32 start = UiTraceReplay_GetTime();
+    const ui_trace_record_t *records;
+    unsigned num_records;
+    unsigned pio_changed;
+    unsigned ui_input = 0;
+    ui_trace_heap_stats_t heap;
+
+    UiTraceReplay_Run(gesture->edges, gesture->num_edges, GESTURE_SETTLE_MS);
+    records = UiTraceReplay_GetRecords(&num_records);
+    UiTraceReplay_GetHeapStats(&heap);
+    pio_changed = testUiTrace_CountPioChanged(records, num_records);
+
+    printf("%s: %u PIO changed, %u IEM timers, %u logical inputs, %u UI inputs, %u allocations (%u bytes)\n",
+           gesture->name, pio_changed,
+           UiTraceReplay_CountMessages(iem_task) - pio_changed,
+           UiTraceReplay_CountMessages(LogicalInputSwitch_GetTask()),
+           UiTraceReplay_CountMessages(&ui_input_consumer),
+           heap.allocations, (unsigned)heap.bytes_allocated);
+
+    for (unsigned i = 0; i < num_records; i++)
+    {
+        if (records[i].task != &ui_input_consumer)
+            continue;
+
+        printf("    %04x at +%lu ms\n", records[i].id, (unsigned long)(records[i].time - start));
+
+        TEST_ASSERT(ui_input < gesture->num_ui_inputs);
+        TEST_ASSERT_EQUAL(gesture->ui_inputs[ui_input].ui_input, records[i].id);
+        TEST_ASSERT_EQUAL(gesture->ui_inputs[ui_input].latency, records[i].time - start);
+        ui_input++;
+
+        if (num_latencies < MAX_LATENCIES)
+            latencies[num_latencies++] = records[i].time - start;
+    }
+
+    TEST_ASSERT_EQUAL(gesture->num_ui_inputs, ui_input);
+    TEST_ASSERT_EQUAL(gesture->pio_changed_messages, pio_changed);
+    TEST_ASSERT_EQUAL(gesture->iem_timer_messages, UiTraceReplay_CountMessages(iem_task) - pio_changed);
+    TEST_ASSERT_EQUAL(gesture->logical_inputs, UiTraceReplay_CountMessages(LogicalInputSwitch_GetTask()));
+    TEST_ASSERT_EQUAL(gesture->logical_inputs, UiTraceReplay_CountMessages(Ui_GetUiTask()));
+    TEST_ASSERT_EQUAL(gesture->heap_allocations, heap.allocations);
+    TEST_ASSERT_EQUAL(heap.allocations, heap.frees);
+}
+
+static void test_UiTraceSingleClick(void)
+{
+    testUiTrace_Gesture(&gestures[0]);
+}
+
+static void test_UiTraceDoubleClick(void)
+{
+    testUiTrace_Gesture(&gestures[1]);
+}
+
+static void test_UiTraceHeld(void)
+{
+    testUiTrace_Gesture(&gestures[2]);
+}
+
+static void test_UiTraceHeldRelease(void)
+{
+    testUiTrace_Gesture(&gestures[3]);
+}
+
+static int testUiTrace_CompareLatency(const void *a, const void *b)
+{
+    const uint32 latency_a = *(const uint32 *)a;
+    const uint32 latency_b = *(const uint32 *)b;
+
+    return (latency_a > latency_b) - (latency_a < latency_b);
+}
+
+static void testUiTrace_ReportLatencies(void)
+{
+    if (!num_latencies)
+        return;
+
+    qsort(latencies, num_latencies, sizeof(latencies[0]), testUiTrace_CompareLatency);
+
+    printf("Press to UI input latency over %u UI inputs: min %lu ms, median %lu ms, max %lu ms\n",
+           num_latencies,
+           (unsigned long)latencies[0],
+           (unsigned long)latencies[num_latencies / 2],
+           (unsigned long)latencies[num_latencies - 1]);
+}
+
+void test_ui_trace(void)
+{
+    testUiTrace_Setup();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_UiTraceSingleClick);
+    RUN_TEST(test_UiTraceDoubleClick);
+    RUN_TEST(test_UiTraceHeld);
+    RUN_TEST(test_UiTraceHeldRelease);
+
+    UNITY_END();
+
+    testUiTrace_ReportLatencies();
+}
@@ -0,0 +1,20 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Trace replay tests for the UI input path.
+*/
+
+#ifndef TEST_UI_TRACE_H_
+#define TEST_UI_TRACE_H_
+
+/*! \brief Test runner for the UI input path trace replay.
+
+    Replays the recorded gestures through the input event manager, logical
+    input switch and ui modules, checks each one against its golden output and
+    reports the press to UI input latency.
+*/
+void test_ui_trace(void);
+
+#endif /* TEST_UI_TRACE_H_ */
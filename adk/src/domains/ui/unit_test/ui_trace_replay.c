@@ -0,0 +1,424 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Replay of timestamped PIO traces through the UI input path on a
+            desktop test build.
+*/
+
+#ifdef DESKTOP_TEST_BUILD
+
+#include "ui_trace_replay.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <panic.h>
+#include <pio.h>
+
+#define NUM_PIO_BANKS   (3)
+
+/*! A queued message */
+typedef struct
+{
+    Task task;
+    MessageId id;
+    void *message;
+    uint32 due;
+    uint32 sequence;
+} queued_message_t;
+
+/*! Debounce state of a PIO bank */
+typedef struct
+{
+    uint32 mask;
+    uint16 reads;
+    uint16 period;
+    uint32 level;
+    uint32 debounced;
+} pio_bank_t;
+
+static void uiTraceReplay_HandleDebounce(Task task, MessageId id, Message message);
+
+static TaskData debounce_task = { uiTraceReplay_HandleDebounce };
+static Task pio_task = NULL;
+static pio_bank_t pio_banks[NUM_PIO_BANKS];
+
+static queued_message_t queue[UI_TRACE_REPLAY_MAX_QUEUED];
+static unsigned num_queued = 0;
+static uint32 next_sequence = 0;
+static uint32 now = 0;
+
+static ui_trace_record_t records[UI_TRACE_REPLAY_MAX_RECORDS];
+static unsigned num_records = 0;
+static ui_trace_heap_stats_t heap;
+
+/******************************************************************************
+ * Message queue
+ ******************************************************************************/
+static void uiTraceReplay_Enqueue(Task task, MessageId id, void *message, uint32 delay)
+{
+    queued_message_t *entry;
+
+    if (num_queued == UI_TRACE_REPLAY_MAX_QUEUED)
+        Panic();
+
+    entry = &queue[num_queued++];
+    entry->task = task;
+    entry->id = id;
+    entry->message = message;
+    entry->due = now + ((delay == D_IMMEDIATE) ? 0 : delay);
+    entry->sequence = next_sequence++;
+}
+
+/*! Check if a message body is still queued, the body of a multicast
+    message is shared by all its recipients */
+static bool uiTraceReplay_IsQueued(const void *message)
+{
+    for (unsigned i = 0; i < num_queued; i++)
+    {
+        if (queue[i].message == message)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void uiTraceReplay_Dequeue(unsigned index, bool free_message)
+{
+    void *message = queue[index].message;
+
+    queue[index] = queue[--num_queued];
+
+    if (free_message && message && !uiTraceReplay_IsQueued(message))
+        free(message);
+}
+
+static bool uiTraceReplay_FindNext(uint32 time, unsigned *index)
+{
+    bool found = FALSE;
+
+    for (unsigned i = 0; i < num_queued; i++)
+    {
+        if (queue[i].due > time)
+            continue;
+
+        /* Messages due at the same time are delivered in the order sent */
+        if (!found ||
+            queue[i].due < queue[*index].due ||
+            (queue[i].due == queue[*index].due && queue[i].sequence < queue[*index].sequence))
+        {
+            *index = i;
+            found = TRUE;
+        }
+    }
+    return found;
+}
+
+static void uiTraceReplay_Record(Task task, MessageId id)
+{
+    ui_trace_record_t *record;
+
+    /* Debouncing is part of the firmware, not the code under test */
+    if (task == &debounce_task)
+        return;
+
+    if (num_records == UI_TRACE_REPLAY_MAX_RECORDS)
+        Panic();
+
+    record = &records[num_records++];
+    record->time = now;
+    record->task = task;
+    record->id = id;
+}
+
+void UiTraceReplay_RunUntil(uint32 time)
+{
+    unsigned index;
+
+    while (uiTraceReplay_FindNext(time, &index))
+    {
+        queued_message_t entry = queue[index];
+
+        /* Take the message off the queue before delivering it, the handler
+           may send or cancel messages. The body is freed after delivery. */
+        uiTraceReplay_Dequeue(index, FALSE);
+        now = entry.due;
+
+        uiTraceReplay_Record(entry.task, entry.id);
+        entry.task->handler(entry.task, entry.id, entry.message);
+
+        if (entry.message && !uiTraceReplay_IsQueued(entry.message))
+            free(entry.message);
+    }
+
+    if (time > now)
+        now = time;
+}
+
+/******************************************************************************
+ * PIO debounce model
+ ******************************************************************************/
+static void uiTraceReplay_HandleDebounce(Task task, MessageId id, Message message)
+{
+    pio_bank_t *bank = &pio_banks[id];
+    uint32 level = bank->level & bank->mask;
+
+    UNUSED(task);
+    UNUSED(message);
+
+    if (level != (bank->debounced & bank->mask))
+    {
+        bank->debounced = (bank->debounced & ~bank->mask) | level;
+
+        if (pio_task)
+        {
+            MessagePioChanged *mpc = PanicUnlessNew(MessagePioChanged);
+
+            mpc->state = (uint16)(bank->debounced & 0xFFFF);
+            mpc->state16to31 = (uint16)(bank->debounced >> 16);
+            mpc->time = now;
+            mpc->bank = (uint16)id;
+            MessageSend(pio_task, MESSAGE_PIO_CHANGED, mpc);
+        }
+    }
+}
+
+static void uiTraceReplay_SetPio(uint8 pio, bool level)
+{
+    const uint16 bank_index = pio / 32;
+    const uint32 pio_mask = 1UL << (pio % 32);
+    pio_bank_t *bank = &pio_banks[bank_index];
+
+    if (level)
+        bank->level |= pio_mask;
+    else
+        bank->level &= ~pio_mask;
+
+    /* Every edge restarts the stable period of the bank */
+    if (bank->mask & pio_mask)
+    {
+        (void)MessageCancelAll(&debounce_task, bank_index);
+        MessageSendLater(&debounce_task, bank_index, NULL, (uint32)bank->reads * bank->period);
+    }
+}
+
+void UiTraceReplay_Run(const ui_trace_edge_t *edges, unsigned num_edges, uint32 settle_ms)
+{
+    const uint32 start = now;
+    uint32 end = start;
+
+    for (unsigned i = 0; i < num_edges; i++)
+    {
+        UiTraceReplay_RunUntil(start + edges[i].time);
+        uiTraceReplay_SetPio(edges[i].pio, edges[i].level);
+        end = start + edges[i].time;
+    }
+
+    UiTraceReplay_RunUntil(end + settle_ms);
+}
+
+/******************************************************************************
+ * Results
+ ******************************************************************************/
+void UiTraceReplay_ClearRecords(void)
+{
+    num_records = 0;
+    memset(&heap, 0, sizeof(heap));
+}
+
+uint32 UiTraceReplay_GetTime(void)
+{
+    return now;
+}
+
+const ui_trace_record_t *UiTraceReplay_GetRecords(unsigned *count)
+{
+    *count = num_records;
+    return records;
+}
+
+unsigned UiTraceReplay_CountMessages(Task task)
+{
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < num_records; i++)
+    {
+        if (records[i].task == task)
+            count++;
+    }
+    return count;
+}
+
+void UiTraceReplay_GetHeapStats(ui_trace_heap_stats_t *stats)
+{
+    *stats = heap;
+}
+
+/******************************************************************************
+ * Message traps
+ ******************************************************************************/
+void MessageSend(Task task, MessageId id, void *message)
+{
+    MessageSendLater(task, id, message, D_IMMEDIATE);
+}
+
+void MessageSendLater(Task task, MessageId id, void *message, uint32 delay)
+{
+    if (task)
+        uiTraceReplay_Enqueue(task, id, message, delay);
+    else
+        free(message);
+}
+
+void MessageSendMulticastLater(Task *tasks, MessageId id, void *message, uint32 delay)
+{
+    bool sent = FALSE;
+
+    for (; *tasks; tasks++)
+    {
+        uiTraceReplay_Enqueue(*tasks, id, message, delay);
+        sent = TRUE;
+    }
+
+    if (!sent)
+        free(message);
+}
+
+uint16 MessageCancelAll(Task task, MessageId id)
+{
+    uint16 cancelled = 0;
+    unsigned i = 0;
+
+    while (i < num_queued)
+    {
+        if (queue[i].task == task && queue[i].id == id)
+        {
+            uiTraceReplay_Dequeue(i, TRUE);
+            cancelled++;
+        }
+        else
+        {
+            i++;
+        }
+    }
+    return cancelled;
+}
+
+Task MessagePioTask(Task task)
+{
+    Task old_task = pio_task;
+
+    pio_task = task;
+    return old_task;
+}
+
+/******************************************************************************
+ * PIO traps
+ ******************************************************************************/
+uint32 PioSetMapPins32Bank(uint16 bank, uint32 mask, uint32 bits)
+{
+    UNUSED(bank);
+    UNUSED(mask);
+    UNUSED(bits);
+    return 0;
+}
+
+void PioSetDeepSleepEitherLevelBank(uint16 bank, uint32 mask, uint32 value)
+{
+    UNUSED(bank);
+    UNUSED(mask);
+    UNUSED(value);
+}
+
+uint32 PioSetDir32Bank(uint16 bank, uint32 mask, uint32 dir)
+{
+    UNUSED(bank);
+    UNUSED(mask);
+    UNUSED(dir);
+    return 0;
+}
+
+uint32 PioDebounce32Bank(uint16 bank, uint32 mask, uint16 count, uint16 period)
+{
+    if (bank >= NUM_PIO_BANKS)
+        return mask;
+
+    pio_banks[bank].mask = mask;
+    pio_banks[bank].reads = count;
+    pio_banks[bank].period = period;
+    pio_banks[bank].debounced = pio_banks[bank].level;
+    return 0;
+}
+
+uint32 PioGet32Bank(uint16 bank)
+{
+    return (bank < NUM_PIO_BANKS) ? pio_banks[bank].level : 0;
+}
+
+/******************************************************************************
+ * Panic traps
+ ******************************************************************************/
+void Panic(void)
+{
+    printf("PANIC at %lu ms\n", (unsigned long)now);
+    abort();
+}
+
+void *PanicNull(void *pointer)
+{
+    if (pointer == NULL)
+        Panic();
+    return pointer;
+}
+
+void PanicNotNull(const void *pointer)
+{
+    if (pointer != NULL)
+        Panic();
+}
+
+void *PanicUnlessMalloc(size_t size)
+{
+    return PanicNull(malloc(size));
+}
+
+/******************************************************************************
+ * Heap counting, see the link flags in ui_trace_replay.h
+ ******************************************************************************/
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+void __real_free(void *pointer);
+
+void *__wrap_malloc(size_t size)
+{
+    heap.allocations++;
+    heap.bytes_allocated += size;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    heap.allocations++;
+    heap.bytes_allocated += count * size;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size)
+{
+    heap.allocations++;
+    heap.bytes_allocated += size;
+    if (pointer)
+        heap.frees++;
+    return __real_realloc(pointer, size);
+}
+
+void __wrap_free(void *pointer)
+{
+    if (pointer)
+        heap.frees++;
+    __real_free(pointer);
+}
+
+#endif /* DESKTOP_TEST_BUILD */
@@ -0,0 +1,98 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Replay of timestamped PIO traces through the UI input path on a
+            desktop test build.
+
+    The replay provides the message, PIO and panic traps used by the input
+    event manager, logical input switch and ui modules, so the real code runs
+    against a simulated clock. Messages are delivered in due time order and
+    every delivered message is recorded with its simulated time.
+
+    PIO debouncing is modelled from the settings passed to PioDebounce32Bank():
+    a bank is reported in a MESSAGE_PIO_CHANGED once its debounced PIOs have
+    been stable for debounce_reads * debounce_period ms.
+
+    Heap allocations are counted by wrapping the C library allocator, so the
+    replay must be linked with
+    -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+
+    As it replaces traps the replay only builds for the host, with the
+    Makefile in this directory.
+*/
+
+#ifndef UI_TRACE_REPLAY_H_
+#define UI_TRACE_REPLAY_H_
+
+#include <csrtypes.h>
+#include <message.h>
+
+/*! Maximum number of messages that can be queued at once */
+#define UI_TRACE_REPLAY_MAX_QUEUED      (64)
+
+/*! Maximum number of delivered messages that are recorded */
+#define UI_TRACE_REPLAY_MAX_RECORDS     (256)
+
+/*! One edge of a PIO trace, relative to the start of the trace */
+typedef struct
+{
+    uint32 time;
+    uint8 pio;
+    bool level;
+} ui_trace_edge_t;
+
+/*! A message delivered during a replay */
+typedef struct
+{
+    uint32 time;
+    Task task;
+    MessageId id;
+} ui_trace_record_t;
+
+/*! Heap use during a replay */
+typedef struct
+{
+    unsigned allocations;
+    unsigned frees;
+    size_t bytes_allocated;
+} ui_trace_heap_stats_t;
+
+/*! \brief Discard any recorded messages and reset the heap counters.
+
+    Queued messages and the simulated time are kept, so a replay can follow
+    on from the previous one.
+*/
+void UiTraceReplay_ClearRecords(void);
+
+/*! \brief Replay a PIO trace.
+
+    \param edges The PIO edges, in time order. Edge times are relative to the
+                 current simulated time.
+    \param num_edges Number of edges in the trace.
+    \param settle_ms Time to keep running after the last edge, so that any
+                     timers started by the trace expire.
+*/
+void UiTraceReplay_Run(const ui_trace_edge_t *edges, unsigned num_edges, uint32 settle_ms);
+
+/*! \brief Run the message loop until the simulated time reaches time. */
+void UiTraceReplay_RunUntil(uint32 time);
+
+/*! \brief Get the current simulated time in ms. */
+uint32 UiTraceReplay_GetTime(void);
+
+/*! \brief Get the messages delivered since the records were last cleared.
+
+    \param num_records Set to the number of records.
+    \return The records, in delivery order.
+*/
+const ui_trace_record_t *UiTraceReplay_GetRecords(unsigned *num_records);
+
+/*! \brief Count the recorded messages delivered to a task. */
+unsigned UiTraceReplay_CountMessages(Task task);
+
+/*! \brief Get the heap use since the records were last cleared. */
+void UiTraceReplay_GetHeapStats(ui_trace_heap_stats_t *stats);
+
+#endif /* UI_TRACE_REPLAY_H_ */
@@ -259,6 +259,15 @@ download the required downloadable capability bundles.
 
 The application has to specify which files in the read only filesystem contain
 downloadable capability bundles by calling ChainSetDownloadableCapabilityBundleConfig().
+
+## Operator role index
+
+A chain configuration may point to an operator_role_index_t. This maps each
+operator role to the operator's position in the operator_config array, so
+ChainGetOperatorByRole() and everything built on it (connecting, configuring,
+getting inputs and outputs) is a table lookup rather than a scan of the
+operators. Chain definitions generated by chaingen always include an index.
+Configurations without one still work, they just use the scan.
  
 # Examples
 
@@ -454,6 +463,21 @@ typedef struct
     const operator_config_t* operator_filters;
 } operator_filters_t;
 
+/*! Maps operator roles to operators in chain_config_t::operator_config.
+ */
+typedef struct
+{
+    /*! The lowest operator role in the chain. */
+    unsigned first_role;
+    /*! Number of members of index array. */
+    unsigned number_of_roles;
+    /*! index[role - first_role] is the position of the operator with that
+        role in the operator_config array plus one, or zero if no operator
+        has that role.
+     */
+    const uint8 *index;
+} operator_role_index_t;
+
 /*! Message to be sent to an operator after it is created
     Note that there is no support for messages with response */
 typedef struct
@@ -497,6 +521,8 @@ typedef struct
     const operator_path_t *paths;
     /*! Number of members of paths array. */
     unsigned number_of_paths;
+    /*! Optional operator role index, NULL if there isn't one. */
+    const operator_role_index_t *role_index;
 } chain_config_t;
 
 typedef struct _chain_join_roles
@@ -747,6 +773,14 @@ bool ChainStartAttempt(kymera_chain_handle_t handle);
 */
 void ChainStop(kymera_chain_handle_t handle);
 
+/*! \brief Reset the operators of a stopped chain to their initial state.
+
+The chain must be stopped first. The operators drop any data they hold, so
+the chain can be started again without playing what was left in it. Operator
+settings should be configured again before the chain is restarted.
+*/
+void ChainReset(kymera_chain_handle_t handle);
+
 /*! \brief Connect the outputs of one chain to the inputs of another.
 */
 void ChainJoin(kymera_chain_handle_t source_chain, kymera_chain_handle_t sink_chain, unsigned count, const chain_join_roles_t *connect_list);
@@ -73,6 +73,10 @@ typedef struct
 } message_broker_group_registration_t;
 
 /*! \brief MessageBroker_Init
+
+    Builds a table of the registrations indexed by message group, so that
+    registering interest in a group does not search the registrations.
+
     \param registrations Pointer to an array of registration structures.
     \param registrations_len The number of registrations in the array.
 */
@@ -80,6 +84,9 @@ void MessageBroker_Init(const message_broker_group_registration_t *registrations
                         unsigned registrations_len);
 
 /*! \brief MessageBroker_RegisterInterestInMsgGroups
+
+    A client should register all of its message groups in a single call.
+
     \param task the client's message handler, i.e. where the message broker shall send the interested messages to
     \param msg_groups pointer to the array of message groups the client is registering interest in
     \param num_groups the number of message groups the client is registering interest in
@@ -249,6 +249,9 @@ static void handleDisconnectReq(AHI_DISCONNECT_REQ_T *req)
     if (ahiGetTransportTask() == req->transport_task)
         ahiSetTransportTask(0);
 
+    /* Store any config writes from this session now the Host has finished. */
+    ConfigStoreFlush();
+
 #ifdef ENABLE_REBOOT_AFTER_DISCONNECT
     if (ahiIsRebootNeeded())
     {
@@ -652,6 +655,7 @@ static void handleAppModeSetReboot(void)
        have been processed. */
     if (ahiCanSendTransportData())
     {
+        ConfigStoreFlush();
         BootSetMode(BootGetMode());
     }
     else
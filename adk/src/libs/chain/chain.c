@@ -90,8 +90,10 @@ static void chainAddOperators(kymera_chain_t *chain)
         const operator_config_t* op_config = chainConfigGetOperatorConfig(chain, i);
         if(op_config)
         {
-            /* Operator role must be unique within the chain */
-            PanicFalse(ChainGetOperatorByRole(chain, op_config->role) == INVALID_OPERATOR);
+            /* Operator role must be unique within the chain, chaingen has
+               already checked this for chains with a role index */
+            if(!config->role_index)
+                PanicFalse(ChainGetOperatorByRole(chain, op_config->role) == INVALID_OPERATOR);
             chain->operator_list[i] = CustomOperatorCreate(op_config->capability_id, op_config->processor_id, op_config->priority, &op_config->setup);
         }
     }
@@ -244,6 +246,20 @@ Operator ChainGetOperatorByRole(kymera_chain_handle_t handle, unsigned operator_
     {
         const chain_config_t *config = chain->config;
         unsigned i;
+
+        if(config->role_index)
+        {
+            const operator_role_index_t *role_index = config->role_index;
+            unsigned offset = operator_role - role_index->first_role;
+
+            /* Roles below first_role wrap to large offsets */
+            if(offset < role_index->number_of_roles && role_index->index[offset])
+            {
+                return chain->operator_list[role_index->index[offset] - 1];
+            }
+            return INVALID_OPERATOR;
+        }
+
         for(i = 0; i < config->number_of_operators; ++i)
         {
             if(config->operator_config[i].role == operator_role)
@@ -380,6 +396,17 @@ void ChainStop(kymera_chain_handle_t handle)
     PanicFalse(runFunctionOnMultipleOperators(&OperatorStopMultiple, chain));
 }
 
+/******************************************************************************/
+void ChainReset(kymera_chain_handle_t handle)
+{
+    kymera_chain_t *chain = handle;
+
+    PanicNull(chain);
+    PRINT(("ChainReset() %p\n", chain));
+
+    PanicFalse(runFunctionOnMultipleOperators(&OperatorResetMultiple, chain));
+}
+
 /******************************************************************************/
 void ChainJoin(kymera_chain_handle_t source_chain, kymera_chain_handle_t sink_chain, unsigned count, const chain_join_roles_t *connect_list)
 {
@@ -57,11 +57,16 @@ typedef struct __config_block
 } config_block_t;
 
 
-/* Private Config Store data */
+/* Private Config Store data.
+   Config blocks in use are kept packed at the start of 'config_blocks',
+   so lookups only visit blocks that are in use and adding a block never
+   has to search for a free slot.
+*/
 typedef struct __config_store_data
 {
     const void     *const_config_set;       /* Configuration Set */
     uint16         num_config_blocks;       /* Number of config blocks that can be stored in 'config_blocks' array */
+    uint16         num_used_config_blocks;  /* Number of config blocks in use, at the start of 'config_blocks' */
     bool           const_mode;              /* Do not read/write config data from/to dynamic config store. */
     config_block_t config_blocks[1];        /* Config blocks */
 } config_store_data_t;
@@ -110,7 +115,7 @@ static config_block_t* getConfigBlock(config_blk_id_t id)
 {
     uint16 i;
 
-    for(i = 0; i < configStore->num_config_blocks; i++)
+    for(i = 0; i < configStore->num_used_config_blocks; i++)
     {
         if(configStore->config_blocks[i].id == id)
         {
@@ -194,9 +199,9 @@ RETURNS
 */
 static bool addConfigBlock(config_blk_id_t id, void * dynamic_config_data, uint16 writeable_config_data_size)
 {
-    config_block_t *unused_config_block = getConfigBlock(CONFIG_BLOCK_ID_UNUSED);
+    config_block_t *unused_config_block;
 
-    if(!unused_config_block)
+    if(configStore->num_used_config_blocks == configStore->num_config_blocks)
     {
         /* Unused config block not found, which means that we have to increase
            amount of memory used for tracking config block requests */
@@ -215,16 +220,14 @@ static bool addConfigBlock(config_blk_id_t id, void * dynamic_config_data, uint1
 
             configStore = reallocated_config_store;
             configStore->num_config_blocks += CONFIG_BLOCK_MEMORY_ALLOC_STEP;
-
-            unused_config_block = getConfigBlock(CONFIG_BLOCK_ID_UNUSED);
         }
-
-        if(!unused_config_block)
+        else
         {
             return FALSE;
         }
     }
 
+    unused_config_block = &configStore->config_blocks[configStore->num_used_config_blocks++];
     unused_config_block->id = id;
     unused_config_block->dynamic_config_data = dynamic_config_data;
     unused_config_block->writeable_config_data_size = writeable_config_data_size;
@@ -252,14 +255,20 @@ static void removeConfigBlock(config_blk_id_t id)
 
     if(config_block_to_remove)
     {
-        config_block_to_remove->id = CONFIG_BLOCK_ID_UNUSED;
+        config_block_t *last_config_block = &configStore->config_blocks[--configStore->num_used_config_blocks];
+
         /* If there was any dynamic memory allocated for this config block - free it */
         if(config_block_to_remove->dynamic_config_data)
         {
             free(config_block_to_remove->dynamic_config_data);
-            resetConfigDataPtrAndSize((void*)&config_block_to_remove->dynamic_config_data,
-                                      &config_block_to_remove->writeable_config_data_size);
         }
+
+        /* Keep the blocks in use packed by moving the last one into the gap */
+        *config_block_to_remove = *last_config_block;
+
+        last_config_block->id = CONFIG_BLOCK_ID_UNUSED;
+        resetConfigDataPtrAndSize((void*)&last_config_block->dynamic_config_data,
+                                  &last_config_block->writeable_config_data_size);
     }
 }
 
@@ -638,3 +647,14 @@ config_store_status_t ConfigStoreDisableConstMode(void)
     
     return config_store_success;
 }
+
+/******************************************************************************/
+config_store_status_t ConfigStoreFlush(void)
+{
+    if (configStore && DynamicConfigFlush() != dynamic_config_success)
+    {
+        return config_store_error_writing_dynamic_data;
+    }
+
+    return config_store_success;
+}
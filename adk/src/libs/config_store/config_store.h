@@ -201,4 +201,16 @@ config_store_status_t ConfigStoreResetToDefaults(void);
 */
 config_store_status_t ConfigStoreDisableConstMode(void);
 
+
+/*!
+    @brief Make sure all config blocks written so far are in persistent storage.
+
+    The dynamic store may hold back part of a write for a short time so that
+    a burst of writes is stored together. This function should be called
+    before powering off or rebooting.
+
+    @return Status of the operation, appropriate error code if operation fails.
+*/
+config_store_status_t ConfigStoreFlush(void);
+
 #endif /* _CONFIG_STORE_H_*/
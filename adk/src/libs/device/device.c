@@ -22,18 +22,27 @@ struct device_tag
     key_value_list_t properties;
 };
 
+static device_property_changed_callback_t property_changed_callback = NULL;
+
+static void device_NotifyPropertyChanged(device_t device, device_property_t id)
+{
+    if (property_changed_callback)
+        property_changed_callback(device, id);
+}
+
 static bool device_UpdatePropertyIfExistingHelper(device_t device, device_property_t id, uint32 value, size_t size)
 {
     bool was_set = TRUE;
     if (!KeyValueList_Add(device->properties, id, &value, size))
     {
-        Device_RemoveProperty(device, id);
+        KeyValueList_Remove(device->properties, id);
         if (!KeyValueList_Add(device->properties, id, &value, size))
         {
             was_set = FALSE;
             Panic();
         }
     }
+    device_NotifyPropertyChanged(device, id);
     return was_set;
 }
 
@@ -68,6 +77,7 @@ void Device_RemoveProperty(device_t device, device_property_t id)
 {
     PanicNull(device);
     KeyValueList_Remove(device->properties, id);
+    device_NotifyPropertyChanged(device, id);
 }
 
 bool Device_SetProperty(device_t device, device_property_t id, const void *value, size_t size)
@@ -75,9 +85,10 @@ bool Device_SetProperty(device_t device, device_property_t id, const void *value
     PanicNull(device);
     if (!KeyValueList_Add(device->properties, id, value, size))
     {
-        Device_RemoveProperty(device, id);
+        KeyValueList_Remove(device->properties, id);
         PanicFalse(KeyValueList_Add(device->properties, id, value, size));
     }
+    device_NotifyPropertyChanged(device, id);
     return TRUE;
 }
 
@@ -89,8 +100,14 @@ bool Device_GetProperty(device_t device, device_property_t id, void **value, siz
 
 bool Device_SetPropertyPtr(device_t device, device_property_t id, const void *value)
 {
+    bool was_set;
+
     PanicNull(device);
-    return KeyValueList_Add(device->properties, id, &value, sizeof(value));
+    was_set = KeyValueList_Add(device->properties, id, &value, sizeof(value));
+    if (was_set)
+        device_NotifyPropertyChanged(device, id);
+
+    return was_set;
 }
 
 void *Device_GetPropertyPtr(device_t device, device_property_t id)
@@ -171,3 +188,8 @@ bool Device_GetPropertyU8(device_t device, device_property_t id, uint8 *value)
 
     return found;
 }
+
+void Device_RegisterPropertyChangedCallback(device_property_changed_callback_t callback)
+{
+    property_changed_callback = callback;
+}
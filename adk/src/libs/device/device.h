@@ -17,6 +17,13 @@ typedef struct device_tag * device_t;
 /*! \brief A device property is represented by a 16bit unsigned integer. */
 typedef uint16 device_property_t;
 
+/*! \brief Callback made when a property of a device is set or removed.
+
+    \param device Device whose property has changed.
+    \param id Property that has changed.
+*/
+typedef void (*device_property_changed_callback_t)(device_t device, device_property_t id);
+
 /*! \brief Create a new device_t object.
 
     If allocating memory for the new object fails this function will panic.
@@ -191,4 +198,14 @@ bool Device_SetPropertyU8(device_t device, device_property_t id, uint8 value);
 */
 bool Device_GetPropertyU8(device_t device, device_property_t id, uint8 *value);
 
+/*! \brief Register a callback for changes to device properties.
+
+    The callback is made after any property of any device is set or removed.
+    It is not made when a device is destroyed. Only one callback is supported;
+    registering a new one replaces the previous one.
+
+    \param callback Function to call, or NULL to stop the callback.
+*/
+void Device_RegisterPropertyChangedCallback(device_property_changed_callback_t callback);
+
 #endif // DEVICE_H_
@@ -123,4 +123,12 @@ int16 DynamicConfigGetConfigSize(const void *const_config_data, config_blk_id_t
 */
 dynamic_config_status_t DynamicConfigResetToDefaults(void);
 
+/*!
+    @brief  Write any changes the dynamic store is holding back to persistent
+            storage. Call this before powering off or rebooting.
+    
+    @return                         Status of the operation.
+*/
+dynamic_config_status_t DynamicConfigFlush(void);
+
 #endif /* _DYNAMIC_CONFIG_IF_H_ */
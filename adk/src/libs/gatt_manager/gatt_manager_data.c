@@ -9,6 +9,8 @@ Copyright (c) 2014 - 2019 Qualcomm Technologies International, Ltd.
 #include "gatt_manager_internal.h"
 #include "gatt_manager_data.h"
 
+/* Servers are kept sorted by start handle. Their handle ranges never
+   overlap, so a handle can be resolved with a binary search. */
 typedef struct __gatt_manager_server_lookup
 {
     uint16                            count;
@@ -341,25 +343,67 @@ const gatt_manager_server_lookup_data_t * gattManagerDataServerIteratorNext(gatt
     return data;
 }
 
-static bool gattManagerDataServerHandlesValid(const gatt_manager_server_registration_params_t *server)
+/* Returns the index of the first server with a start handle greater than
+   the given handle, which is where a server starting at that handle would
+   be inserted. */
+static uint16 gattManagerDataServerUpperBound(uint16 handle)
 {
-    uint16 index;
-    if (0 == gatt_manager_data->server_lookup.count)
-    {
-        return TRUE;
-    }
+    uint16 low = 0;
+    uint16 high = gatt_manager_data->server_lookup.count;
 
-    for (index = 0; index < gatt_manager_data->server_lookup.count; ++index)
+    while (low < high)
     {
-        if ((server->start_handle >= gatt_manager_data->server_lookup.table[index].start_handle &&
-             server->start_handle <= gatt_manager_data->server_lookup.table[index].end_handle) ||
-            (server->end_handle >= gatt_manager_data->server_lookup.table[index].start_handle &&
-             server->end_handle <= gatt_manager_data->server_lookup.table[index].end_handle))
+        uint16 mid = low + (high - low) / 2;
+
+        if (gatt_manager_data->server_lookup.table[mid].start_handle <= handle)
+        {
+            low = mid + 1;
+        }
+        else
         {
-            return FALSE;
+            high = mid;
         }
     }
 
+    return low;
+}
+
+static gatt_manager_server_lookup_data_t * gattManagerDataFindServerByHandle(uint16 handle)
+{
+    uint16 index = gattManagerDataServerUpperBound(handle);
+
+    /* The only server that can contain the handle is the one before the
+       upper bound, with the highest start handle not above it */
+    if (index && handle <= gatt_manager_data->server_lookup.table[index - 1].end_handle)
+    {
+        return &gatt_manager_data->server_lookup.table[index - 1];
+    }
+
+    return NULL;
+}
+
+static bool gattManagerDataServerHandlesValid(const gatt_manager_server_registration_params_t *server,
+                                              uint16 insert_index)
+{
+    if (server->start_handle > server->end_handle)
+    {
+        return FALSE;
+    }
+
+    /* The table is sorted and has no overlaps, so only the neighbours
+       either side of the insert position need checking */
+    if (insert_index &&
+        server->start_handle <= gatt_manager_data->server_lookup.table[insert_index - 1].end_handle)
+    {
+        return FALSE;
+    }
+
+    if (insert_index < gatt_manager_data->server_lookup.count &&
+        server->end_handle >= gatt_manager_data->server_lookup.table[insert_index].start_handle)
+    {
+        return FALSE;
+    }
+
     return TRUE;
 }
 
@@ -376,8 +420,14 @@ bool gattManagerDataAddServer(const gatt_manager_server_registration_params_t *s
         return FALSE;
     }
 
-    if (NULL == gattManagerDataGetDB() ||
-        !gattManagerDataServerHandlesValid(server))
+    if (NULL == gattManagerDataGetDB())
+    {
+        return FALSE;
+    }
+
+    idx = gattManagerDataServerUpperBound(server->start_handle);
+
+    if (!gattManagerDataServerHandlesValid(server, idx))
     {
         return FALSE;
     }
@@ -388,7 +438,12 @@ bool gattManagerDataAddServer(const gatt_manager_server_registration_params_t *s
     GATT_MANAGER_PANIC_NULL(ptr, ("GM: Realloc Failed!"));
 
     gatt_manager_data->server_lookup.table = (gatt_manager_server_lookup_data_t*)ptr;
-    idx = gatt_manager_data->server_lookup.count;
+
+    /* Make room to keep the table sorted by start handle */
+    memmove(&gatt_manager_data->server_lookup.table[idx + 1],
+            &gatt_manager_data->server_lookup.table[idx],
+            (gatt_manager_data->server_lookup.count - idx) * sizeof(gatt_manager_server_lookup_data_t));
+
     gatt_manager_data->server_lookup.table[idx].task  = server->task;
 
     gatt_manager_data->server_lookup.table[idx].start_handle = server->start_handle;
@@ -438,29 +493,18 @@ uint16 gattManagerDataGetServerDatabaseHandle(Task task, uint16 handle)
 
 gatt_manager_server_lookup_data_t * gattManagerDataFindServerTask(uint16 handle)
 {
-    uint16 index;
-
     if (NULL == gatt_manager_data ||
         NULL == gatt_manager_data->server_lookup.table)
     {
         return NULL;
     }
 
-    for (index = 0; index < gatt_manager_data->server_lookup.count; ++index)
-    {
-        if ( (handle >= gatt_manager_data->server_lookup.table[index].start_handle) &&
-             (handle <= gatt_manager_data->server_lookup.table[index].end_handle) )
-        {
-            return &gatt_manager_data->server_lookup.table[index];
-        }
-    }
-
-    return NULL;
+    return gattManagerDataFindServerByHandle(handle);
 }
 
 bool gattManagerDataResolveServerHandle(gatt_manager_resolve_server_handle_t * data)
 {
-    unsigned index;
+    const gatt_manager_server_lookup_data_t *server;
 
     if (NULL == gatt_manager_data ||
         NULL == gatt_manager_data->server_lookup.table ||
@@ -469,15 +513,13 @@ bool gattManagerDataResolveServerHandle(gatt_manager_resolve_server_handle_t * d
         return FALSE;
     }
 
-    for (index = 0; index < gatt_manager_data->server_lookup.count; ++index)
+    server = gattManagerDataFindServerByHandle(data->handle);
+
+    if (server)
     {
-        if ( (gatt_manager_data->server_lookup.table[index].start_handle <= data->handle) &&
-             (gatt_manager_data->server_lookup.table[index].end_handle   >= data->handle) )
-        {
-            data->adjusted = ((data->handle - gatt_manager_data->server_lookup.table[index].start_handle) + 1);
-            data->task = gatt_manager_data->server_lookup.table[index].task;
-            return TRUE;
-        }
+        data->adjusted = ((data->handle - server->start_handle) + 1);
+        data->task = server->task;
+        return TRUE;
     }
 
     return FALSE;
@@ -485,7 +527,7 @@ bool gattManagerDataResolveServerHandle(gatt_manager_resolve_server_handle_t * d
 
 void gattManagerDataSetServerPendingWriteFlag(uint16 handle)
 {
-    uint16 index;
+    gatt_manager_server_lookup_data_t *server;
 
     if (NULL == gatt_manager_data ||
         NULL == gatt_manager_data->server_lookup.table)
@@ -494,14 +536,11 @@ void gattManagerDataSetServerPendingWriteFlag(uint16 handle)
     }
     
     /* Set the pending write flag on the server that uses the specified handle */
+    server = gattManagerDataFindServerByHandle(handle);
 
-    for (index = 0; index < gatt_manager_data->server_lookup.count; ++index)
+    if (server)
     {
-        if ( (handle >= gatt_manager_data->server_lookup.table[index].start_handle) &&
-             (handle <= gatt_manager_data->server_lookup.table[index].end_handle) )
-        {
-            gatt_manager_data->server_lookup.table[index].pending_write = TRUE;
-        }
+        server->pending_write = TRUE;
     }
 }
 
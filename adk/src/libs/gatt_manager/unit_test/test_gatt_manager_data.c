@@ -0,0 +1,319 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the server handle resolution of the GATT Manager data,
+            checked against a scan of the server ranges added.
+*/
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hydra_macros.h>
+#include <panic.h>
+
+#include "gatt_manager_internal.h"
+#include "gatt_manager_data.h"
+#include "test_gatt_manager_data.h"
+
+/*! Most servers the tests add */
+#define MAX_SERVERS         (64)
+
+/*! Random ranges added, and the handles they are drawn from */
+#define RANDOM_ADDS         (200)
+#define RANDOM_HANDLES      (2000)
+#define RANDOM_MAX_RANGE    (60)
+
+/*! Handles checked, a little past the highest one used */
+#define CHECKED_HANDLES     (RANDOM_HANDLES + RANDOM_MAX_RANGE + 40)
+
+/*! Server tasks, one per server added */
+static TaskData server_tasks[MAX_SERVERS];
+
+static const uint16 gatt_db[] = {0};
+
+static struct
+{
+    /*! Servers accepted so far, in the order they were added */
+    gatt_manager_server_registration_params_t servers[MAX_SERVERS];
+    unsigned num_servers;
+    uint32 random;
+} fake;
+
+/******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static void testGattManagerData_Handler(Task task, MessageId id, Message message)
+{
+    UNUSED(task);
+    UNUSED(id);
+    UNUSED(message);
+}
+
+static TaskData application_task = {testGattManagerData_Handler};
+
+/*! Add a server for handles start to end, recording it if it is accepted */
+static bool testGattManagerData_AddServer(uint16 start, uint16 end)
+{
+    gatt_manager_server_registration_params_t server;
+
+    if (fake.num_servers >= MAX_SERVERS)
+        Panic();
+
+    server.task = &server_tasks[fake.num_servers];
+    server.start_handle = start;
+    server.end_handle = end;
+
+    if (!gattManagerDataAddServer(&server))
+        return FALSE;
+
+    fake.servers[fake.num_servers++] = server;
+    return TRUE;
+}
+
+/*! Whether a range overlaps a server added already, or is reversed */
+static bool testGattManagerData_ScanRejects(uint16 start, uint16 end)
+{
+    if (start > end)
+        return TRUE;
+
+    for (unsigned i = 0; i < fake.num_servers; i++)
+    {
+        if (start <= fake.servers[i].end_handle && end >= fake.servers[i].start_handle)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/*! The server added for a handle, by scanning the servers added */
+static const gatt_manager_server_registration_params_t *testGattManagerData_ScanServers(uint16 handle)
+{
+    for (unsigned i = 0; i < fake.num_servers; i++)
+    {
+        if (handle >= fake.servers[i].start_handle && handle <= fake.servers[i].end_handle)
+            return &fake.servers[i];
+    }
+    return NULL;
+}
+
+/*! Check every handle up to last resolves as a scan of the servers would */
+static bool testGattManagerData_HandlesMatchScan(uint16 last)
+{
+    for (uint32 handle = 0; handle <= last; handle++)
+    {
+        const gatt_manager_server_registration_params_t *expected = testGattManagerData_ScanServers(handle);
+        gatt_manager_resolve_server_handle_t resolve = {NULL, handle, 0};
+        gatt_manager_server_lookup_data_t *found = gattManagerDataFindServerTask(handle);
+
+        if (expected)
+        {
+            if (!found || found->task != expected->task ||
+                !gattManagerDataResolveServerHandle(&resolve) ||
+                resolve.task != expected->task ||
+                resolve.adjusted != handle - expected->start_handle + 1)
+            {
+                printf("handle %u resolved wrongly\n", (unsigned)handle);
+                return FALSE;
+            }
+        }
+        else if (found || gattManagerDataResolveServerHandle(&resolve))
+        {
+            printf("handle %u resolved when no server has it\n", (unsigned)handle);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static uint32 testGattManagerData_Random(uint32 range)
+{
+    fake.random = fake.random * 1103515245u + 12345u;
+    return (fake.random >> 16) % range;
+}
+
+/******************************************************************************
+ * Tests
+ ******************************************************************************/
+void setUp(void)
+{
+    memset(&fake, 0, sizeof(fake));
+    fake.random = 1;
+    gattManagerDataInit(testGattManagerData_Handler, &application_task);
+    gattManagerDataSetConstDB(gatt_db, sizeof(gatt_db));
+}
+
+void tearDown(void)
+{
+    gattManagerDataDeInit();
+}
+
+static void test_NothingResolvesWithoutServers(void)
+{
+    gatt_manager_resolve_server_handle_t resolve = {NULL, 1, 0};
+
+    TEST_ASSERT(gattManagerDataFindServerTask(1) == NULL);
+    TEST_ASSERT(!gattManagerDataResolveServerHandle(&resolve));
+    TEST_ASSERT(!gattManagerDataResolveServerHandle(NULL));
+}
+
+static void test_ServersAddedInAnyOrder(void)
+{
+    gatt_manager_data_iterator_t iter;
+    const gatt_manager_server_lookup_data_t *server;
+    uint16 last_start = 0;
+    unsigned count = 0;
+
+    TEST_ASSERT(testGattManagerData_AddServer(50, 59));
+    TEST_ASSERT(testGattManagerData_AddServer(10, 19));
+    TEST_ASSERT(testGattManagerData_AddServer(30, 30));
+    TEST_ASSERT(testGattManagerData_AddServer(20, 29));
+    TEST_ASSERT(testGattManagerData_AddServer(1, 5));
+    TEST_ASSERT_EQUAL(5, gattManagerDataServerCount());
+
+    TEST_ASSERT(testGattManagerData_HandlesMatchScan(70));
+
+    /* The iterator walks the servers by start handle */
+    gattManagerDataServerIteratorStart(&iter);
+    while ((server = gattManagerDataServerIteratorNext(&iter)) != NULL)
+    {
+        TEST_ASSERT(server->start_handle > last_start);
+        last_start = server->start_handle;
+        count++;
+    }
+    TEST_ASSERT_EQUAL(5, count);
+}
+
+static void test_OverlappingServersRejected(void)
+{
+    TEST_ASSERT(testGattManagerData_AddServer(10, 19));
+    TEST_ASSERT(testGattManagerData_AddServer(30, 39));
+
+    TEST_ASSERT(!testGattManagerData_AddServer(10, 19));    /* Same range */
+    TEST_ASSERT(!testGattManagerData_AddServer(5, 10));     /* Overlaps the start */
+    TEST_ASSERT(!testGattManagerData_AddServer(19, 25));    /* Overlaps the end */
+    TEST_ASSERT(!testGattManagerData_AddServer(12, 15));    /* Inside */
+    TEST_ASSERT(!testGattManagerData_AddServer(5, 25));     /* Encloses */
+    TEST_ASSERT(!testGattManagerData_AddServer(15, 35));    /* Spans two */
+    TEST_ASSERT(!testGattManagerData_AddServer(28, 22));    /* Reversed */
+
+    /* Touching either side is fine */
+    TEST_ASSERT(testGattManagerData_AddServer(20, 29));
+    TEST_ASSERT(testGattManagerData_AddServer(9, 9));
+    TEST_ASSERT(testGattManagerData_AddServer(40, 40));
+    TEST_ASSERT_EQUAL(5, gattManagerDataServerCount());
+
+    TEST_ASSERT(testGattManagerData_HandlesMatchScan(50));
+}
+
+static void test_AddServerNeedsDatabase(void)
+{
+    gattManagerDataDeInit();
+    gattManagerDataInit(testGattManagerData_Handler, &application_task);
+
+    TEST_ASSERT(!testGattManagerData_AddServer(1, 10));
+    TEST_ASSERT(!gattManagerDataAddServer(NULL));
+}
+
+static void test_PendingWriteFlagSetByHandle(void)
+{
+    gatt_manager_data_iterator_t iter;
+    gatt_manager_server_lookup_data_t server;
+
+    TEST_ASSERT(testGattManagerData_AddServer(20, 29));
+    TEST_ASSERT(testGattManagerData_AddServer(1, 9));
+    TEST_ASSERT(testGattManagerData_AddServer(10, 19));
+
+    gattManagerDataSetServerPendingWriteFlag(15);
+    gattManagerDataSetServerPendingWriteFlag(100);
+
+    gattManagerDataServerIteratorStart(&iter);
+    TEST_ASSERT(gattManagerDataServerIteratorPrepareWriteFlagsNext(&server, &iter));
+    TEST_ASSERT(server.task == &server_tasks[2]);
+    TEST_ASSERT(!gattManagerDataServerIteratorPrepareWriteFlagsNext(&server, &iter));
+}
+
+static void test_DatabaseHandleByTask(void)
+{
+    TEST_ASSERT(testGattManagerData_AddServer(20, 29));
+    TEST_ASSERT(testGattManagerData_AddServer(1, 9));
+
+    /* Handles relative to the server's first handle, which is 1 */
+    TEST_ASSERT_EQUAL(20, gattManagerDataGetServerDatabaseHandle(&server_tasks[0], 1));
+    TEST_ASSERT_EQUAL(29, gattManagerDataGetServerDatabaseHandle(&server_tasks[0], 10));
+    TEST_ASSERT_EQUAL(0, gattManagerDataGetServerDatabaseHandle(&server_tasks[0], 11));
+    TEST_ASSERT_EQUAL(5, gattManagerDataGetServerDatabaseHandle(&server_tasks[1], 5));
+    TEST_ASSERT_EQUAL(0, gattManagerDataGetServerDatabaseHandle(&application_task, 1));
+}
+
+static void test_RandomRangesMatchScan(void)
+{
+    unsigned accepted = 0;
+
+    for (unsigned i = 0; i < RANDOM_ADDS && fake.num_servers < MAX_SERVERS; i++)
+    {
+        uint16 start = 1 + testGattManagerData_Random(RANDOM_HANDLES);
+        uint16 end = start + testGattManagerData_Random(RANDOM_MAX_RANGE);
+        bool rejected;
+
+        /* Now and then a reversed range */
+        if (!testGattManagerData_Random(10))
+        {
+            uint16 swap = start;
+            start = end + 1;
+            end = swap;
+        }
+
+        rejected = testGattManagerData_ScanRejects(start, end);
+        TEST_ASSERT_EQUAL(!rejected, testGattManagerData_AddServer(start, end));
+        if (!rejected)
+            accepted++;
+    }
+
+    TEST_ASSERT_EQUAL(accepted, gattManagerDataServerCount());
+    TEST_ASSERT(testGattManagerData_HandlesMatchScan(CHECKED_HANDLES));
+    printf("gatt_manager_data: %u of %u random ranges accepted\n", accepted, RANDOM_ADDS);
+}
+
+void test_gatt_manager_data(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_NothingResolvesWithoutServers);
+    RUN_TEST(test_ServersAddedInAnyOrder);
+    RUN_TEST(test_OverlappingServersRejected);
+    RUN_TEST(test_AddServerNeedsDatabase);
+    RUN_TEST(test_PendingWriteFlagSetByHandle);
+    RUN_TEST(test_DatabaseHandleByTask);
+    RUN_TEST(test_RandomRangesMatchScan);
+
+    UNITY_END();
+}
+
+/******************************************************************************
+ * Panic fakes
+ ******************************************************************************/
+void Panic(void)
+{
+    printf("PANIC\n");
+    abort();
+}
+
+void *PanicNull(void *pointer)
+{
+    if (pointer == NULL)
+        Panic();
+    return pointer;
+}
+
+void PanicNotNull(const void *pointer)
+{
+    if (pointer != NULL)
+        Panic();
+}
+
+void *PanicUnlessMalloc(size_t size)
+{
+    return PanicNull(malloc(size));
+}
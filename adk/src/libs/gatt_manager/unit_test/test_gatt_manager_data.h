@@ -0,0 +1,20 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the server handle resolution of the GATT Manager data.
+*/
+
+#ifndef TEST_GATT_MANAGER_DATA_H_
+#define TEST_GATT_MANAGER_DATA_H_
+
+/*! \brief Test runner for gatt_manager_data.c.
+
+    Adds server handle ranges, including overlapping and reversed ones, and
+    checks which are accepted and how every handle resolves against a scan
+    of the accepted ranges.
+*/
+void test_gatt_manager_data(void);
+
+#endif /* TEST_GATT_MANAGER_DATA_H_ */
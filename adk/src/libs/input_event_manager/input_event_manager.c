@@ -228,6 +228,13 @@ static void inputEventsChanged(InputEventState_t *state, input_event_bits_t inpu
 
     IEM_DEBUG(("IEM: Updated input events %08x\n", input_event_bits));
 
+    /* Nothing to do unless an input event used by the action table changed */
+    if (!(changed_bits & state->action_table_mask))
+    {
+        state->input_event_bits = input_event_bits;
+        return;
+    }
+
     /* Go through the action table to determine what action to do and
        what message may need to be sent. */
     for (;input_action != &(state->action_table[size]); input_action++)
@@ -270,20 +277,29 @@ static void inputEventsChanged(InputEventState_t *state, input_event_bits_t inpu
     state->input_event_bits = input_event_bits;
 }
 
+static input_event_bits_t calculateBankInputEvents(InputEventState_t *state, uint16 bank)
+{
+    int pio;
+    const uint8 pio_base = bank * 32;
+    uint32 pio_state = state->pio_state[bank];
+    input_event_bits_t input_event_bits = 0;
+
+    /* Only visit PIOs up to the highest one that is set */
+    for (pio = 0; pio_state; pio++, pio_state >>= 1)
+    {
+        if (pio_state & 1)
+            input_event_bits |= (1UL << state->config->pio_mapping[pio_base + pio]);
+    }
+    return input_event_bits;
+}
+
 static uint32 calculateInputEvents(InputEventState_t *state)
 {
-    int pio, bank;
+    int bank;
     uint32 input_event_bits = 0;
     for (bank = 0; bank < IEM_NUM_BANKS; bank++)
     {
-        const uint8 pio_base = bank * 32;
-        const uint32 pio_state = state->pio_state[bank];
-        for (pio = 0; pio < 32; pio++)
-        {
-            const uint32 pio_mask = 1UL << pio;
-            if (pio_state & pio_mask)
-                input_event_bits |= (1UL << state->config->pio_mapping[pio_base + pio]);
-        }
+        input_event_bits |= state->bank_input_event_bits[bank];
     }
     return input_event_bits;
 }
@@ -297,8 +313,9 @@ static void handleMessagePioChangedEvents(InputEventState_t *state, const Messag
 
     if (state->pio_state[mpc->bank] != pio_state_masked)
     {
-        /* Update our copy of the PIO state */
+        /* Update our copy of the PIO state, and the input events of this bank */
         state->pio_state[mpc->bank] = pio_state_masked;
+        state->bank_input_event_bits[mpc->bank] = calculateBankInputEvents(state, mpc->bank);
 
         /* Calculate input events from PIO state and handle them */
         inputEventsChanged(state, calculateInputEvents(state));
@@ -311,6 +328,10 @@ static void handleMessagePioChangedClients(InputEventState_t *state, const Messa
     InputEventClient_t *client = NULL;
     const uint32 pio_state = (mpc->state) + ((uint32)mpc->state16to31 << 16);
 
+    /* Most changes are for banks without any client tasks */
+    if (!state->client_pio_mask[mpc->bank])
+        return;
+
     for (client = state->client_list; client != NULL; client = client->next)
     {
         const int client_bank = client->pio / 32;
@@ -473,6 +494,21 @@ static void setStartupStates(InputEventState_t *state)
     }
 }
 
+/*! Recalculate the PIOs with client tasks in the bank of the given PIO */
+static void updateClientPioMask(uint8 pio)
+{
+    InputEventClient_t *client;
+    const uint32 pio_bank = pio / 32;
+    uint32 pio_bank_mask = 0;
+
+    for (client = input_event_manager_state.client_list; client != NULL; client = client->next)
+    {
+        if (client->pio / 32 == pio_bank)
+            pio_bank_mask |= 1UL << (client->pio % 32);
+    }
+    input_event_manager_state.client_pio_mask[pio_bank] = pio_bank_mask;
+}
+
 /*! Add a client to the list of clients */
 static bool addClient(Task task, uint8 pio)
 {
@@ -489,7 +525,7 @@ static bool addClient(Task task, uint8 pio)
         client->next = input_event_manager_state.client_list;
         client->state = (bank_state & bank_pio_mask) ? 1 : 0;
         input_event_manager_state.client_list = client;
-
+        updateClientPioMask(pio);
 
         IEM_DEBUG(("IEM: addClient pio %d, state %d\n", pio, client->state));
 
@@ -510,6 +546,7 @@ static void removeClient(Task task, uint8 pio)
             InputEventClient_t *to_remove = *head;
             *head = (*head)->next;
             free(to_remove);
+            updateClientPioMask(pio);
             IEM_DEBUG(("IEM: removeClient pio %d\n", pio));
             break;
         }
@@ -559,6 +596,11 @@ Task InputEventManagerInit(Task client,
     input_event_manager_state.num_action_messages = size_action_table / sizeof(InputActionMessage_t);
     input_event_manager_state.config = config;
 
+    for (; action_table != &input_event_manager_state.action_table[input_event_manager_state.num_action_messages]; action_table++)
+    {
+        input_event_manager_state.action_table_mask |= action_table->mask;
+    }
+
     return &input_event_manager_state.task;
 }
 
@@ -54,6 +54,16 @@ typedef struct
 
     /* PIO deep sleep wake up state PS Key setting */
     uint32 pio_state[IEM_NUM_BANKS];
+
+    /* The input event bits from the PIOs in each bank, so a PIO change
+       only needs the bits for its own bank recalculating */
+    input_event_bits_t bank_input_event_bits[IEM_NUM_BANKS];
+
+    /* All the input event bits used by the action table */
+    input_event_bits_t action_table_mask;
+
+    /* PIOs in each bank with at least one registered client task */
+    uint32 client_pio_mask[IEM_NUM_BANKS];
 } InputEventState_t;
 
 /* Task messages */
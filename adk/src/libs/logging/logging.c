@@ -7,6 +7,10 @@
 */
 
 #include <logging.h>
+#include <vm.h>
+
+/*! Length of a rate limit window in milliseconds */
+#define LOGGING_RATE_LIMIT_WINDOW_MS    (1000)
 
 /*! Sequence variable used in debug output so that missing log items can be detected. 
 
@@ -18,3 +22,37 @@
  */
 uint16 globalDebugLineCount = 0;
 
+/*! Count of log entries dropped by rate limiting, across all modules. */
+uint32 globalDebugDroppedCount = 0;
+
+bool loggingRateLimitCheck(logging_rate_limit_t *limit, uint16 max_per_second, const char *module)
+{
+    uint32 now = VmGetClock();
+
+    if (now - limit->window_start >= LOGGING_RATE_LIMIT_WINDOW_MS)
+    {
+        uint16 dropped = limit->dropped;
+
+        limit->window_start = now;
+        limit->logged = 0;
+        limit->dropped = 0;
+
+        if (dropped)
+        {
+            DEBUG_LOG("logging: %u entries dropped by rate limit in %s", dropped, module);
+        }
+    }
+
+    if (limit->logged < max_per_second)
+    {
+        limit->logged++;
+        return TRUE;
+    }
+
+    if (limit->dropped < 0xFFFF)
+    {
+        limit->dropped++;
+    }
+    globalDebugDroppedCount++;
+    return FALSE;
+}
@@ -18,6 +18,12 @@
     at the top of a particular source file would allow logging on a 
     module basis.
 
+    A busy module can limit how much it logs by defining LOGGING_RATE_LIMIT
+    to the maximum number of DEBUG_LOG() entries per second at the top of
+    the source file, before any includes. Entries over the limit are dropped,
+    and the number dropped is logged with the file name before the module's
+    next entry.
+
     \note The DEBUG_LOG() macro write condensed information 
     to a logging area and <b>can only be decoded if the original 
     application image file (.elf) is available</b>.
@@ -105,8 +111,34 @@ extern void hydra_log_firm_variadic(const char *event_key, size_t n_args, ...);
 
 extern uint16 globalDebugLineCount;
 
+/*! Number of DEBUG_LOG() entries dropped by LOGGING_RATE_LIMIT in all modules */
+extern uint32 globalDebugDroppedCount;
+
+/*! \cond internals */
+
+/*! Per-module rate limit state, used when LOGGING_RATE_LIMIT is defined */
+typedef struct
+{
+    uint32 window_start;
+    uint16 logged;
+    uint16 dropped;
+} logging_rate_limit_t;
+
+extern bool loggingRateLimitCheck(logging_rate_limit_t *limit, uint16 max_per_second, const char *module);
+
+/*! \endcond internals */
+
 #ifndef DISABLE_LOG
 
+/*! \cond internals */
+#ifdef LOGGING_RATE_LIMIT
+static logging_rate_limit_t logging_rate_limit;
+#define LOGGING_ALLOWED()   loggingRateLimitCheck(&logging_rate_limit, LOGGING_RATE_LIMIT, __FILE__)
+#else
+#define LOGGING_ALLOWED()   TRUE
+#endif
+/*! \endcond internals */
+
 #if !defined(DESKTOP_BUILD) && defined(INSTALL_HYDRA_LOG)
 /*! \brief  Display the supplied string in the condensed log
 
@@ -114,14 +146,22 @@ extern uint16 globalDebugLineCount;
  */
 #define DEBUG_LOG(...) \
             do { \
-                HYDRA_LOG_STRING(log_fmt, EXTRA_LOGGING_STRING FMT(__VA_ARGS__,bonus_arg)); \
-                hydra_log_firm_variadic(log_fmt, VA_NARGS(__VA_ARGS__) + EXTRA_LOGGING_NUM_PARAMS EXTRA_LOGGING_PARAMS MAKE_REST_OF_ARGS(VA_ANY_ARGS(__VA_ARGS__))(__VA_ARGS__)); \
+                if (LOGGING_ALLOWED()) \
+                { \
+                    HYDRA_LOG_STRING(log_fmt, EXTRA_LOGGING_STRING FMT(__VA_ARGS__,bonus_arg)); \
+                    hydra_log_firm_variadic(log_fmt, VA_NARGS(__VA_ARGS__) + EXTRA_LOGGING_NUM_PARAMS EXTRA_LOGGING_PARAMS MAKE_REST_OF_ARGS(VA_ANY_ARGS(__VA_ARGS__))(__VA_ARGS__)); \
+                } \
             } while (0)
 
 #else   /* DESKTOP_BUILD */
 /* Hydra long on desktop builds just runs using printf */
 #define DEBUG_LOG(...) \
-            printf(FMT(__VA_ARGS__,bonus_arg) "\n" MAKE_REST_OF_ARGS(VA_ANY_ARGS(__VA_ARGS__))(__VA_ARGS__))
+            do { \
+                if (LOGGING_ALLOWED()) \
+                { \
+                    printf(FMT(__VA_ARGS__,bonus_arg) "\n" MAKE_REST_OF_ARGS(VA_ANY_ARGS(__VA_ARGS__))(__VA_ARGS__)); \
+                } \
+            } while (0)
 #endif  /* DESKTOP_BUILD */
 
 /*! \brief  Include a string, without parameters in the 
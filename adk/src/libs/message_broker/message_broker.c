@@ -13,6 +13,8 @@
 
 #include <panic.h>
 #include <vmtypes.h>
+#include <stdlib.h>
+#include <string.h>
 
 #ifndef MESSAGE_BROKER_DEBUG_LIB
 #define DISABLE_LOG
@@ -27,22 +29,102 @@ typedef struct
 
     /*! The number of registrations in the array. */
     unsigned registrations_len;
+
+    /*! Registrations in message group order. The registrations for group g
+        are group_registrations[group_start[g]] to
+        group_registrations[group_start[g + 1] - 1]. */
+    const message_broker_group_registration_t **group_registrations;
+
+    /*! Index into group_registrations of the first registration for each
+        group, with one extra entry marking the end. */
+    uint16 *group_start;
+
+    /*! One more than the highest message group with a registration. */
+    message_group_t num_groups;
 } message_broker_state_t;
 
 static message_broker_state_t message_broker_state;
 
 
+/*! \brief Build the group indexed table of registrations.
+
+    This is a counting sort on message group, so the registrations for each
+    group keep their order in the registrations array.
+*/
+static void messageBroker_BuildGroupTable(void)
+{
+    message_broker_state_t *state = &message_broker_state;
+    const message_broker_group_registration_t *registration;
+    message_group_t group;
+
+    free(state->group_registrations);
+    free(state->group_start);
+    state->group_registrations = NULL;
+    state->group_start = NULL;
+    state->num_groups = 0;
+
+    if (!state->registrations_len)
+    {
+        return;
+    }
+
+    for (registration = state->registrations;
+         registration < (state->registrations + state->registrations_len);
+         registration++)
+    {
+        if (registration->message_group >= state->num_groups)
+        {
+            state->num_groups = registration->message_group + 1;
+        }
+    }
+
+    state->group_registrations = PanicUnlessMalloc(state->registrations_len * sizeof(*state->group_registrations));
+    state->group_start = PanicUnlessMalloc((state->num_groups + 1) * sizeof(*state->group_start));
+    memset(state->group_start, 0, (state->num_groups + 1) * sizeof(*state->group_start));
+
+    /* Count the registrations in each group, offset by one so that the
+       running total below gives the start of each group */
+    for (registration = state->registrations;
+         registration < (state->registrations + state->registrations_len);
+         registration++)
+    {
+        state->group_start[registration->message_group + 1]++;
+    }
+
+    for (group = 0; group < state->num_groups; group++)
+    {
+        state->group_start[group + 1] += state->group_start[group];
+    }
+
+    /* Place each registration, using the end marker of the previous group as
+       the next free slot, then shift the markers back afterwards */
+    for (registration = state->registrations;
+         registration < (state->registrations + state->registrations_len);
+         registration++)
+    {
+        state->group_registrations[state->group_start[registration->message_group]++] = registration;
+    }
+
+    for (group = state->num_groups; group > 0; group--)
+    {
+        state->group_start[group] = state->group_start[group - 1];
+    }
+    state->group_start[0] = 0;
+}
+
 void MessageBroker_Init(const message_broker_group_registration_t *registrations,
                         unsigned registrations_len)
 {
     message_broker_state.registrations = registrations;
     message_broker_state.registrations_len = registrations_len;
+
+    messageBroker_BuildGroupTable();
 }
 
 void MessageBroker_RegisterInterestInMsgGroups(Task task, const message_group_t *msg_groups, unsigned num_groups)
 {
     message_group_t msg_group_index;
-    const message_broker_group_registration_t *registration;
+    const message_broker_state_t *state = &message_broker_state;
 
     if (task == NULL || msg_groups == NULL)
     {
@@ -54,15 +136,14 @@ void MessageBroker_RegisterInterestInMsgGroups(Task task, const message_group_t
         message_group_t group = msg_groups[msg_group_index];
         bool registered = FALSE;
 
-        for (registration = message_broker_state.registrations;
-             registration < (message_broker_state.registrations + message_broker_state.registrations_len);
-             registration++)
+        if (group < state->num_groups)
         {
-            if (group == registration->message_group)
+            uint16 index;
+
+            for (index = state->group_start[group]; index < state->group_start[group + 1]; index++)
             {
-                registration->MessageGroupRegister(task, group);
+                state->group_registrations[index]->MessageGroupRegister(task, group);
                 registered = TRUE;
-
             }
         }
 
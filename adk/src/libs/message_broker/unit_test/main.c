@@ -0,0 +1,22 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Message broker unit tests, built for the host with
+            DESKTOP_TEST_BUILD, see the Makefile.
+*/
+
+#include <stdio.h>
+#include "unity.h"
+#include "test_message_broker.h"
+
+
+/* Message broker unit tests */
+int main (void)
+{
+    /* Test runner for test_message_broker.c */
+    test_message_broker();
+
+    return unity_failures ? 1 : 0;
+}
@@ -0,0 +1,304 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the message group lookup of the message broker, run
+            against test registration tables.
+*/
+
+#include "unity.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <hydra_macros.h>
+#include <panic.h>
+
+#include "message_broker.h"
+#include "test_message_broker.h"
+
+/*! Most register calls recorded */
+#define MAX_CALLS           (32)
+
+/*! Size and group range of the random registration tables */
+#define RANDOM_TABLES       (50)
+#define RANDOM_TABLE_LEN    (20)
+#define RANDOM_GROUPS       (12)
+
+/*! A call to one of the register functions */
+typedef struct
+{
+    /*! Which register function, 'A', 'B' or 'C' */
+    char function;
+    Task task;
+    message_group_t group;
+} register_call_t;
+
+static TaskData client;
+
+static struct
+{
+    register_call_t calls[MAX_CALLS];
+    unsigned num_calls;
+    /*! Where Panic() returns to when a test expects one */
+    jmp_buf *panic_return;
+    uint32 random;
+} fake;
+
+static void testMessageBroker_RegisterA(Task task, message_group_t group);
+static void testMessageBroker_RegisterB(Task task, message_group_t group);
+static void testMessageBroker_RegisterC(Task task, message_group_t group);
+
+/*! Several registrations for groups 1 and 3, and gaps at 0, 2 and 4 to 6 */
+static const message_broker_group_registration_t registrations[] =
+{
+    { 3, testMessageBroker_RegisterA, NULL },
+    { 1, testMessageBroker_RegisterB, NULL },
+    { 3, testMessageBroker_RegisterB, NULL },
+    { 7, testMessageBroker_RegisterC, NULL },
+    { 1, testMessageBroker_RegisterA, NULL },
+    { 3, testMessageBroker_RegisterC, NULL },
+};
+
+/******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static void testMessageBroker_Record(char function, Task task, message_group_t group)
+{
+    if (fake.num_calls >= MAX_CALLS)
+        Panic();
+
+    fake.calls[fake.num_calls].function = function;
+    fake.calls[fake.num_calls].task = task;
+    fake.calls[fake.num_calls].group = group;
+    fake.num_calls++;
+}
+
+static void testMessageBroker_RegisterA(Task task, message_group_t group)
+{
+    testMessageBroker_Record('A', task, group);
+}
+
+static void testMessageBroker_RegisterB(Task task, message_group_t group)
+{
+    testMessageBroker_Record('B', task, group);
+}
+
+static void testMessageBroker_RegisterC(Task task, message_group_t group)
+{
+    testMessageBroker_Record('C', task, group);
+}
+
+static char testMessageBroker_Function(void (*register_fn)(Task, message_group_t))
+{
+    if (register_fn == testMessageBroker_RegisterA)
+        return 'A';
+    if (register_fn == testMessageBroker_RegisterB)
+        return 'B';
+    return 'C';
+}
+
+/*! Check the calls recorded, from first, are the table's rows for group in
+    table order, and return the number of them */
+static unsigned testMessageBroker_CheckCalls(const message_broker_group_registration_t *table, unsigned table_len,
+                                             message_group_t group, unsigned first)
+{
+    unsigned call = first;
+
+    for (unsigned row = 0; row < table_len; row++)
+    {
+        if (table[row].message_group == group)
+        {
+            if (call >= fake.num_calls ||
+                fake.calls[call].function != testMessageBroker_Function(table[row].MessageGroupRegister) ||
+                fake.calls[call].task != &client ||
+                fake.calls[call].group != group)
+            {
+                return 0;
+            }
+            call++;
+        }
+    }
+    return call - first;
+}
+
+/*! Register interest in groups and return TRUE if the message broker panicked */
+static bool testMessageBroker_Panics(Task task, const message_group_t *groups, unsigned num_groups)
+{
+    jmp_buf panic_return;
+    bool panicked = TRUE;
+
+    fake.panic_return = &panic_return;
+    if (!setjmp(panic_return))
+    {
+        MessageBroker_RegisterInterestInMsgGroups(task, groups, num_groups);
+        panicked = FALSE;
+    }
+    fake.panic_return = NULL;
+    return panicked;
+}
+
+static uint32 testMessageBroker_Random(uint32 range)
+{
+    fake.random = fake.random * 1103515245u + 12345u;
+    return (fake.random >> 16) % range;
+}
+
+/******************************************************************************
+ * Tests
+ ******************************************************************************/
+void setUp(void)
+{
+    memset(&fake, 0, sizeof(fake));
+    fake.random = 1;
+    MessageBroker_Init(registrations, ARRAY_DIM(registrations));
+}
+
+void tearDown(void)
+{
+}
+
+static void test_GroupCallsItsRegistrationsInOrder(void)
+{
+    static const message_group_t group3[] = {3};
+
+    MessageBroker_RegisterInterestInMsgGroups(&client, group3, ARRAY_DIM(group3));
+
+    TEST_ASSERT_EQUAL(3, fake.num_calls);
+    TEST_ASSERT_EQUAL(3, testMessageBroker_CheckCalls(registrations, ARRAY_DIM(registrations), 3, 0));
+}
+
+static void test_SeveralGroupsInOneCall(void)
+{
+    static const message_group_t groups[] = {7, 1};
+
+    MessageBroker_RegisterInterestInMsgGroups(&client, groups, ARRAY_DIM(groups));
+
+    TEST_ASSERT_EQUAL(3, fake.num_calls);
+    TEST_ASSERT_EQUAL(1, testMessageBroker_CheckCalls(registrations, ARRAY_DIM(registrations), 7, 0));
+    TEST_ASSERT_EQUAL(2, testMessageBroker_CheckCalls(registrations, ARRAY_DIM(registrations), 1, 1));
+}
+
+static void test_UnregisteredGroupPanics(void)
+{
+    static const message_group_t gaps[] = {0, 2, 4, 6, 8, 0xffff};
+    static const message_group_t group1[] = {1};
+
+    for (unsigned i = 0; i < ARRAY_DIM(gaps); i++)
+    {
+        TEST_ASSERT(testMessageBroker_Panics(&client, &gaps[i], 1));
+    }
+    TEST_ASSERT_EQUAL(0, fake.num_calls);
+
+    TEST_ASSERT(testMessageBroker_Panics(NULL, group1, 1));
+    TEST_ASSERT(testMessageBroker_Panics(&client, NULL, 1));
+}
+
+static void test_ReinitReplacesRegistrations(void)
+{
+    static const message_broker_group_registration_t other[] =
+    {
+        { 0, testMessageBroker_RegisterC, NULL },
+    };
+    static const message_group_t group0[] = {0};
+    static const message_group_t group3[] = {3};
+
+    MessageBroker_Init(other, ARRAY_DIM(other));
+    MessageBroker_RegisterInterestInMsgGroups(&client, group0, 1);
+    TEST_ASSERT_EQUAL(1, fake.num_calls);
+    TEST_ASSERT_EQUAL(1, testMessageBroker_CheckCalls(other, ARRAY_DIM(other), 0, 0));
+    TEST_ASSERT(testMessageBroker_Panics(&client, group3, 1));
+
+    /* No registrations at all */
+    MessageBroker_Init(NULL, 0);
+    TEST_ASSERT(testMessageBroker_Panics(&client, group0, 1));
+}
+
+static void test_RandomTablesMatchScan(void)
+{
+    message_broker_group_registration_t table[RANDOM_TABLE_LEN];
+    static void (* const functions[])(Task, message_group_t) =
+    {
+        testMessageBroker_RegisterA, testMessageBroker_RegisterB, testMessageBroker_RegisterC
+    };
+
+    for (unsigned t = 0; t < RANDOM_TABLES; t++)
+    {
+        unsigned table_len = 1 + testMessageBroker_Random(RANDOM_TABLE_LEN);
+
+        for (unsigned row = 0; row < table_len; row++)
+        {
+            table[row].message_group = testMessageBroker_Random(RANDOM_GROUPS);
+            table[row].MessageGroupRegister = functions[testMessageBroker_Random(ARRAY_DIM(functions))];
+            table[row].MessageGroupUnregister = NULL;
+        }
+        MessageBroker_Init(table, table_len);
+
+        for (message_group_t group = 0; group <= RANDOM_GROUPS; group++)
+        {
+            unsigned expected = 0;
+
+            for (unsigned row = 0; row < table_len; row++)
+            {
+                if (table[row].message_group == group)
+                    expected++;
+            }
+
+            fake.num_calls = 0;
+            if (expected)
+            {
+                MessageBroker_RegisterInterestInMsgGroups(&client, &group, 1);
+                TEST_ASSERT_EQUAL(expected, fake.num_calls);
+                TEST_ASSERT_EQUAL(expected, testMessageBroker_CheckCalls(table, table_len, group, 0));
+            }
+            else
+            {
+                TEST_ASSERT(testMessageBroker_Panics(&client, &group, 1));
+            }
+        }
+    }
+}
+
+void test_message_broker(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_GroupCallsItsRegistrationsInOrder);
+    RUN_TEST(test_SeveralGroupsInOneCall);
+    RUN_TEST(test_UnregisteredGroupPanics);
+    RUN_TEST(test_ReinitReplacesRegistrations);
+    RUN_TEST(test_RandomTablesMatchScan);
+
+    UNITY_END();
+}
+
+/******************************************************************************
+ * Panic fakes
+ ******************************************************************************/
+void Panic(void)
+{
+    if (fake.panic_return)
+        longjmp(*fake.panic_return, 1);
+
+    printf("PANIC\n");
+    abort();
+}
+
+void *PanicNull(void *pointer)
+{
+    if (pointer == NULL)
+        Panic();
+    return pointer;
+}
+
+void PanicNotNull(const void *pointer)
+{
+    if (pointer != NULL)
+        Panic();
+}
+
+void *PanicUnlessMalloc(size_t size)
+{
+    return PanicNull(malloc(size));
+}
@@ -0,0 +1,20 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the message group lookup of the message broker.
+*/
+
+#ifndef TEST_MESSAGE_BROKER_H_
+#define TEST_MESSAGE_BROKER_H_
+
+/*! \brief Test runner for message_broker.c.
+
+    Initialises the message broker with registration tables that have
+    several registrations per group and gaps in the group range, and checks
+    which register functions each request for interest calls.
+*/
+void test_message_broker(void);
+
+#endif /* TEST_MESSAGE_BROKER_H_ */
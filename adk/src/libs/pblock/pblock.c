@@ -27,7 +27,10 @@ Copyright (c) 2007 - 2015 Qualcomm Technologies International, Ltd.
          Retrieve data from a keyed block
   
       void PblockSet(uint16 entry_id, uint16 entry_len, uint16 *data)
-         Store data to a keyed block. Entry will be created if not present
+         Store data to a keyed block. Entry will be created if not present,
+         or resized if present with a different length. data must not point
+         into the pblock cache (e.g. at an entry returned by PblockGet), as
+         resizing moves the entries and may move the cache.
 
       Storage format:
          {entry header}
@@ -45,6 +48,10 @@ Copyright (c) 2007 - 2015 Qualcomm Technologies International, Ltd.
          {max_size}
 
    Notes
+      Entries are kept packed in the cache. Resizing an entry removes it,
+      closes the gap and appends the new data at the end.
+      The cache remembers whether it differs from the PS key, so
+      PblockStore only writes the key when an entry has changed.
    */  
 /******************************************************************************/
 
@@ -62,12 +69,14 @@ struct pblock_key_str
     uint16      key;
     unsigned    allocated_len_words:8;
     unsigned    used_len_words:8;       /* Includes header for each block */
+    bool        dirty;                  /* Cache differs from the PS key */
     uint16      cache[1];
 };
 
 #define PBLOCK_START    ((pblock_entry*)&pblock->cache)
 #define PBLOCK_END      ((pblock_entry*)(&pblock->cache + pblock->used_len_words))
-#define for_all_entries(entry)      for(entry = PBLOCK_START; entry < PBLOCK_END; entry = (pblock_entry*)(((uint16*) entry) + entry->size + ENTRY_HDR_SIZE_WORDS))
+#define next_entry(entry)           ((pblock_entry*)(((uint16*) entry) + entry->size + ENTRY_HDR_SIZE_WORDS))
+#define for_all_entries(entry)      for(entry = PBLOCK_START; entry < PBLOCK_END; entry = next_entry(entry))
 #define for_all_data(entry, data)   for(data = entry->data; data < (entry->data + entry->size); data++)
 
 #define ENTRY_HDR_SIZE          (offsetof(pblock_entry,data))
@@ -101,16 +110,11 @@ static void pblockDebug(void)
 #define pblockDebug() ((void)(0))
 #endif
 
-static pblock_entry* pblockAddEntry(uint16 id, uint16 len_words)
+/* Make sure the cache has room for extra_words more than it uses now.
+   The cache may move, so pointers into it must be looked up again. */
+static bool pblockReserve(uint16 extra_words)
 {
-    pblock_entry* entry;
-    uint16 new_used_len_words;
-   
-    /* ensure pblock has been initialised */
-    if (!pblock)
-        return NULL;
-
-    new_used_len_words = pblock->used_len_words + len_words + ENTRY_HDR_SIZE_WORDS;
+    uint16 new_used_len_words = pblock->used_len_words + extra_words;
 
     /* if not enough memory is reserved, increase the malloc'd memory for the key */
     if (new_used_len_words > pblock->allocated_len_words)
@@ -120,18 +124,28 @@ static pblock_entry* pblockAddEntry(uint16 id, uint16 len_words)
         /* add another block of memory and realloc the pblock cache size */
         pblock_temp = (pblock_key*)realloc(pblock,PBLOCK_HDR_SIZE + new_used_len_words * sizeof(uint16)); 
 
-        /* ensure memory is available */
-        if(pblock_temp)
-        {
-            pblock = pblock_temp;
-            pblock->allocated_len_words = new_used_len_words;
-        }
         /* out of memory, extra space not available */
-        else 
-        {
-            PRINT(("PBLOCK: New Entry FAILED, out of memory 0x%02x (size=%d)\n", id, len_words));
-            return NULL;
-        }
+        if(!pblock_temp)
+            return FALSE;
+
+        pblock = pblock_temp;
+        pblock->allocated_len_words = new_used_len_words;
+    }
+    return TRUE;
+}
+
+static pblock_entry* pblockAddEntry(uint16 id, uint16 len_words)
+{
+    pblock_entry* entry;
+   
+    /* ensure pblock has been initialised */
+    if (!pblock)
+        return NULL;
+
+    if (!pblockReserve(len_words + ENTRY_HDR_SIZE_WORDS))
+    {
+        PRINT(("PBLOCK: New Entry FAILED, out of memory 0x%02x (size=%d)\n", id, len_words));
+        return NULL;
     }
 
     /* Need to assign here as block may have moved */
@@ -141,11 +155,23 @@ static pblock_entry* pblockAddEntry(uint16 id, uint16 len_words)
 
     entry->id = id;
     entry->size = len_words;
-    pblock->used_len_words = new_used_len_words;
+    pblock->used_len_words += len_words + ENTRY_HDR_SIZE_WORDS;
    
     return entry;
 }
 
+static void pblockRemoveEntry(pblock_entry* entry)
+{
+    uint16* next = (uint16*)next_entry(entry);
+    uint16  entry_len_words = entry->size + ENTRY_HDR_SIZE_WORDS;
+
+    PRINT(("PBLOCK: Remove Entry 0x%02x (size=%d)\n", entry->id, entry->size));
+
+    /* close the gap by moving the following entries down */
+    memmove(entry, next, ((uint16*)PBLOCK_END - next) * sizeof(uint16));
+    pblock->used_len_words -= entry_len_words;
+}
+
 pblock_key * PblockInit(uint16 key, uint16 len_words)
 {
     /* determine if pskey exists and what size it is */
@@ -160,6 +186,7 @@ pblock_key * PblockInit(uint16 key, uint16 len_words)
     /* initialise pskey id and length */
     pblock->key = key;
     pblock->allocated_len_words = variable_length;
+    pblock->dirty = FALSE;
         
     PRINT(("PBLOCK: Load\n"));
     /* if pskey exists read in data */
@@ -180,8 +207,15 @@ pblock_key * PblockInit(uint16 key, uint16 len_words)
 
 void PblockStore(void)
 {
+    if(!pblock->dirty)
+    {
+        PRINT(("PBLOCK: Store skipped, no changes\n"));
+        return;
+    }
+
     PRINT(("PBLOCK: Store\n"));
     PanicFalse(pblock->used_len_words == PsStore(pblock->key, &pblock->cache, pblock->used_len_words));
+    pblock->dirty = FALSE;
     pblockDebug();
 }
 
@@ -207,12 +241,40 @@ void PblockSet(uint16 id, uint16 len_words, uint16 *data)
 {
     pblock_entry* entry = (pblock_entry*)PblockGet(id);
 
-    if(!entry->size) 
+    if(entry != &empty_pblock)
+    {
+        if(entry->size == len_words)
+        {
+            if(!memcmp(entry->data, data, len_words * sizeof(uint16)))
+                return;
+        }
+        else
+        {
+            /* Grow the cache before removing the old entry, so running out
+               of memory leaves the entry and the dirty flag as they were */
+            if(len_words > entry->size)
+            {
+                if(!pblockReserve(len_words - entry->size))
+                {
+                    PRINT(("PBLOCK: Resize FAILED, out of memory 0x%02x (size=%d)\n", id, len_words));
+                    return;
+                }
+                /* Need to look up again as block may have moved */
+                entry = (pblock_entry*)PblockGet(id);
+            }
+            pblockRemoveEntry(entry);
+            pblock->dirty = TRUE;
+            entry = (pblock_entry*)&empty_pblock;
+        }
+    }
+
+    if(entry == &empty_pblock)
         entry = pblockAddEntry(id, len_words);
     
     if(entry && (entry->size == len_words))
     {
         memmove(entry->data, data, entry->size * sizeof(uint16));
+        pblock->dirty = TRUE;
         PRINT(("PBLOCK: Stored %d words to entry 0x%02x \n", len_words, id ));
     }
 }
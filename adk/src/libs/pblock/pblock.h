@@ -27,7 +27,10 @@ Copyright (c) 2007 - 2015 Qualcomm Technologies International, Ltd.
             Retrieve data from a keyed block
   
         void PblockSet(uint16 entry_id, uint16 entry_len, uint16 *data)
-            Store data to a keyed block. Entry will be created if not present
+            Store data to a keyed block. Entry will be created if not present,
+            or resized if present with a different length. data must not
+            point into the pblock cache (e.g. at an entry returned by
+            PblockGet), as resizing moves the entries and may move the cache.
 
     Notes
         Storage format:
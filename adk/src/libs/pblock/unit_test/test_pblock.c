@@ -0,0 +1,371 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the pblock entry cache and its PS key, run against a
+            fake of the PS traps.
+*/
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <panic.h>
+#include <ps.h>
+
+#include "pblock.h"
+#include "test_pblock.h"
+
+#define PBLOCK_TEST_KEY     (42)
+
+/*! Largest PS key the fake holds, in words */
+#define PS_KEY_MAX_WORDS    (128)
+
+/*! Entry ids and sizes used by the random sequence, small enough that the
+    cache never needs more than PS_KEY_MAX_WORDS */
+#define MODEL_ENTRIES       (8)
+#define MODEL_MAX_WORDS     (6)
+#define MODEL_OPERATIONS    (20000)
+
+/*! What the cache is expected to hold for each entry id */
+typedef struct
+{
+    bool present;
+    uint16 size;
+    uint16 data[MODEL_MAX_WORDS];
+} model_entry_t;
+
+static struct
+{
+    /*! The PS key */
+    uint16 ps_words[PS_KEY_MAX_WORDS];
+    uint16 ps_len;
+    unsigned ps_stores;
+    /*! The pblock cache, as last allocated or reallocated */
+    void *cache;
+    bool fail_realloc;
+    model_entry_t model[MODEL_ENTRIES];
+    uint32 random;
+} fake;
+
+void *__real_realloc(void *ptr, size_t size);
+
+/******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static void testPblock_Init(uint16 len_words)
+{
+    free(fake.cache);
+    fake.cache = PblockInit(PBLOCK_TEST_KEY, len_words);
+}
+
+static bool testPblock_EntryIs(uint16 id, uint16 size, const uint16 *data)
+{
+    const pblock_entry *entry = PblockGet(id);
+
+    return entry->size == size &&
+           !memcmp(entry->data, data, size * sizeof(uint16));
+}
+
+static uint32 testPblock_Random(uint32 range)
+{
+    fake.random = fake.random * 1103515245u + 12345u;
+    return (fake.random >> 16) % range;
+}
+
+/*! Check every entry in the cache matches the model */
+static bool testPblock_MatchesModel(void)
+{
+    for (uint16 id = 0; id < MODEL_ENTRIES; id++)
+    {
+        model_entry_t *model = &fake.model[id];
+
+        if (!testPblock_EntryIs(id, model->present ? model->size : 0, model->data))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/******************************************************************************
+ * Tests
+ ******************************************************************************/
+void setUp(void)
+{
+    memset(fake.ps_words, 0, sizeof(fake.ps_words));
+    fake.ps_len = 0;
+    fake.ps_stores = 0;
+    fake.fail_realloc = FALSE;
+    memset(fake.model, 0, sizeof(fake.model));
+    fake.random = 1;
+    testPblock_Init(0);
+}
+
+void tearDown(void)
+{
+}
+
+static void test_SetAndGet(void)
+{
+    uint16 one[] = {0x1111, 0x1112, 0x1113};
+    uint16 two[] = {0x2221};
+
+    PblockSet(1, 3, one);
+    PblockSet(2, 1, two);
+
+    TEST_ASSERT(testPblock_EntryIs(1, 3, one));
+    TEST_ASSERT(testPblock_EntryIs(2, 1, two));
+    /* An unknown entry reads as empty */
+    TEST_ASSERT_EQUAL(0, PblockGet(3)->size);
+}
+
+static void test_ResizeKeepsOtherEntries(void)
+{
+    uint16 one[] = {0x1111, 0x1112};
+    uint16 two[] = {0x2221, 0x2222};
+    uint16 three[] = {0x3331, 0x3332};
+    uint16 two_long[] = {0xa221, 0xa222, 0xa223, 0xa224};
+    uint16 two_short[] = {0xb221};
+
+    PblockSet(1, 2, one);
+    PblockSet(2, 2, two);
+    PblockSet(3, 2, three);
+
+    PblockSet(2, 4, two_long);
+    TEST_ASSERT(testPblock_EntryIs(1, 2, one));
+    TEST_ASSERT(testPblock_EntryIs(2, 4, two_long));
+    TEST_ASSERT(testPblock_EntryIs(3, 2, three));
+
+    PblockSet(2, 1, two_short);
+    TEST_ASSERT(testPblock_EntryIs(1, 2, one));
+    TEST_ASSERT(testPblock_EntryIs(2, 1, two_short));
+    TEST_ASSERT(testPblock_EntryIs(3, 2, three));
+
+    /* Resized entries are moved to the end of the key */
+    PblockStore();
+    TEST_ASSERT_EQUAL(1 + 2 + 1 + 2 + 1 + 1, fake.ps_len);
+    TEST_ASSERT_EQUAL(0xb221, fake.ps_words[fake.ps_len - 1]);
+}
+
+static void test_StoreOnlyWhenChanged(void)
+{
+    uint16 one[] = {0x1111, 0x1112};
+    uint16 one_changed[] = {0x1111, 0x2222};
+    uint16 empty[] = {0};
+
+    /* Nothing set yet */
+    PblockStore();
+    TEST_ASSERT_EQUAL(0, fake.ps_stores);
+
+    PblockSet(1, 2, one);
+    PblockStore();
+    TEST_ASSERT_EQUAL(1, fake.ps_stores);
+    PblockStore();
+    TEST_ASSERT_EQUAL(1, fake.ps_stores);
+
+    /* The same data again doesn't need a store */
+    PblockSet(1, 2, one);
+    PblockStore();
+    TEST_ASSERT_EQUAL(1, fake.ps_stores);
+
+    PblockSet(1, 2, one_changed);
+    PblockStore();
+    TEST_ASSERT_EQUAL(2, fake.ps_stores);
+
+    /* A zero length entry is added once */
+    PblockSet(2, 0, empty);
+    PblockStore();
+    TEST_ASSERT_EQUAL(3, fake.ps_stores);
+    PblockSet(2, 0, empty);
+    PblockStore();
+    TEST_ASSERT_EQUAL(3, fake.ps_stores);
+    TEST_ASSERT_EQUAL(1 + 2 + 1, fake.ps_len);
+}
+
+static void test_StoredEntriesReload(void)
+{
+    uint16 one[] = {0x1111, 0x1112, 0x1113};
+    uint16 two[] = {0x2221, 0x2222};
+
+    PblockSet(1, 3, one);
+    PblockSet(2, 2, two);
+    PblockStore();
+
+    testPblock_Init(4);
+    TEST_ASSERT(testPblock_EntryIs(1, 3, one));
+    TEST_ASSERT(testPblock_EntryIs(2, 2, two));
+
+    /* Loading doesn't make the key need storing */
+    PblockStore();
+    TEST_ASSERT_EQUAL(1, fake.ps_stores);
+}
+
+static void test_FailedGrowKeepsEntry(void)
+{
+    uint16 one[] = {0x1111, 0x1112};
+    uint16 one_long[] = {0xa111, 0xa112, 0xa113, 0xa114};
+    uint16 two[] = {0x2221};
+
+    /* Room for entry 1 and nothing else */
+    testPblock_Init(2);
+    PblockSet(1, 2, one);
+    PblockStore();
+    TEST_ASSERT_EQUAL(1, fake.ps_stores);
+
+    fake.fail_realloc = TRUE;
+    PblockSet(1, 4, one_long);
+    TEST_ASSERT(testPblock_EntryIs(1, 2, one));
+    PblockSet(2, 1, two);
+    TEST_ASSERT_EQUAL(0, PblockGet(2)->size);
+
+    /* Nothing changed, so nothing to store */
+    PblockStore();
+    TEST_ASSERT_EQUAL(1, fake.ps_stores);
+
+    fake.fail_realloc = FALSE;
+    PblockSet(1, 4, one_long);
+    TEST_ASSERT(testPblock_EntryIs(1, 4, one_long));
+    PblockStore();
+    TEST_ASSERT_EQUAL(2, fake.ps_stores);
+}
+
+static void test_RandomSequenceMatchesModel(void)
+{
+    unsigned stores = 0;
+
+    for (unsigned op = 0; op < MODEL_OPERATIONS; op++)
+    {
+        uint16 id = testPblock_Random(MODEL_ENTRIES);
+        model_entry_t *model = &fake.model[id];
+        uint16 data[MODEL_MAX_WORDS];
+        uint16 size;
+
+        switch (testPblock_Random(8))
+        {
+            case 0:
+                /* Store and read the key back */
+                PblockStore();
+                stores++;
+                testPblock_Init(testPblock_Random(4));
+                break;
+
+            case 1:
+                PblockStore();
+                stores++;
+                break;
+
+            case 2:
+                /* Same size, maybe the same data */
+                if (model->present)
+                {
+                    memcpy(data, model->data, sizeof(data));
+                    if (model->size && testPblock_Random(2))
+                        data[testPblock_Random(model->size)]++;
+                    PblockSet(id, model->size, data);
+                    memcpy(model->data, data, sizeof(data));
+                }
+                break;
+
+            default:
+                size = testPblock_Random(MODEL_MAX_WORDS + 1);
+                memset(data, 0, sizeof(data));
+                for (uint16 i = 0; i < size; i++)
+                    data[i] = (uint16)testPblock_Random(0x10000);
+                PblockSet(id, size, data);
+                model->present = TRUE;
+                model->size = size;
+                memcpy(model->data, data, sizeof(data));
+                break;
+        }
+
+        TEST_ASSERT(testPblock_MatchesModel());
+    }
+
+    PblockStore();
+    testPblock_Init(0);
+    TEST_ASSERT(testPblock_MatchesModel());
+    /* Stores without changes were skipped */
+    TEST_ASSERT(fake.ps_stores < stores);
+    printf("pblock: %u of %u stores wrote the PS key\n", fake.ps_stores, stores);
+}
+
+void test_pblock(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_SetAndGet);
+    RUN_TEST(test_ResizeKeepsOtherEntries);
+    RUN_TEST(test_StoreOnlyWhenChanged);
+    RUN_TEST(test_StoredEntriesReload);
+    RUN_TEST(test_FailedGrowKeepsEntry);
+    RUN_TEST(test_RandomSequenceMatchesModel);
+
+    UNITY_END();
+}
+
+/******************************************************************************
+ * PS trap fakes
+ ******************************************************************************/
+uint16 PsRetrieve(uint16 key, void *buff, uint16 words)
+{
+    uint16 len = fake.ps_len;
+
+    if (key != PBLOCK_TEST_KEY)
+        return 0;
+    if (buff == NULL || words == 0)
+        return len;
+    if (len > words)
+        len = words;
+    memcpy(buff, fake.ps_words, len * sizeof(uint16));
+    return len;
+}
+
+uint16 PsStore(uint16 key, const void *buff, uint16 words)
+{
+    if (key != PBLOCK_TEST_KEY || words > PS_KEY_MAX_WORDS)
+        return 0;
+    memcpy(fake.ps_words, buff, words * sizeof(uint16));
+    fake.ps_len = words;
+    fake.ps_stores++;
+    return words;
+}
+
+/******************************************************************************
+ * Heap fakes
+ ******************************************************************************/
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    void *block;
+
+    if (fake.fail_realloc)
+        return NULL;
+    block = __real_realloc(ptr, size);
+    if (block != NULL)
+        fake.cache = block;
+    return block;
+}
+
+void Panic(void)
+{
+    printf("PANIC\n");
+    abort();
+}
+
+void *PanicNull(void *pointer)
+{
+    if (pointer == NULL)
+        Panic();
+    return pointer;
+}
+
+void PanicNotNull(const void *pointer)
+{
+    if (pointer != NULL)
+        Panic();
+}
+
+void *PanicUnlessMalloc(size_t size)
+{
+    return PanicNull(malloc(size));
+}
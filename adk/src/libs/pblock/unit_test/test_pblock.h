@@ -0,0 +1,20 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Tests for the pblock entry cache and its PS key.
+*/
+
+#ifndef TEST_PBLOCK_H_
+#define TEST_PBLOCK_H_
+
+/*! \brief Test runner for pblock.c.
+
+    Sets, resizes, reads and stores entries, checking them against a model
+    and against what was written to the PS key, including when growing the
+    cache runs out of memory.
+*/
+void test_pblock(void);
+
+#endif /* TEST_PBLOCK_H_ */
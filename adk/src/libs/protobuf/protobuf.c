@@ -188,6 +188,110 @@ static ProtobufCAllocator protobuf_c__allocator = {
     .allocator_data = NULL,
 };
 
+/* --- arena allocator --- */
+
+/* Every arena allocation is rounded up to this many bytes. */
+#define ARENA_ALIGN             sizeof(_uint64_t)
+#define ARENA_ROUND_UP(size)    (((size) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+static void *
+arena_alloc(void *allocator_data, size_t size)
+{
+    ProtobufCArena *arena = allocator_data;
+    size_t rounded = ARENA_ROUND_UP(size);
+
+    if (rounded < size || rounded > arena->scratch - arena->used)
+        return NULL;
+
+    arena->last = arena->used;
+    arena->used += rounded;
+    return arena->block + arena->last;
+}
+
+static void
+arena_free(void *allocator_data, void *data)
+{
+    ProtobufCArena *arena = allocator_data;
+
+    /* Only the most recent allocation can be given back */
+    if ((uint8_t *) data == arena->block + arena->last) {
+        arena->used = arena->last;
+    }
+}
+
+static inline ProtobufCArena *
+get_arena(ProtobufCAllocator *allocator)
+{
+    return allocator->alloc == &arena_alloc ? allocator->allocator_data : NULL;
+}
+
+void
+protobuf_c_arena_init(ProtobufCArena *arena, void *block, size_t size,
+              protobuf_c_boolean bytes_in_place)
+{
+    arena->allocator.alloc = &arena_alloc;
+    arena->allocator.free = &arena_free;
+    arena->allocator.allocator_data = arena;
+    arena->block = block;
+    arena->size = size & ~(ARENA_ALIGN - 1);
+    arena->bytes_in_place = bytes_in_place;
+    protobuf_c_arena_reset(arena);
+}
+
+void
+protobuf_c_arena_reset(ProtobufCArena *arena)
+{
+    arena->used = 0;
+    arena->last = 0;
+    arena->scratch = arena->size;
+}
+
+/*
+ * Scratch memory only lives for the duration of protobuf_c_message_unpack().
+ * In an arena it is taken from the top of the block so that it doesn't sit
+ * between the parts of the unpacked message. It is given back in one go with
+ * scratch_release().
+ */
+static void *
+scratch_alloc(ProtobufCAllocator *allocator, size_t size)
+{
+    ProtobufCArena *arena = get_arena(allocator);
+    size_t rounded = ARENA_ROUND_UP(size);
+
+    if (arena == NULL)
+        return do_alloc(allocator, size);
+
+    if (rounded < size || rounded > arena->scratch - arena->used)
+        return NULL;
+
+    arena->scratch -= rounded;
+    return arena->block + arena->scratch;
+}
+
+static inline void
+scratch_free(ProtobufCAllocator *allocator, void *data)
+{
+    if (get_arena(allocator) == NULL)
+        do_free(allocator, data);
+}
+
+static inline size_t
+scratch_mark(ProtobufCAllocator *allocator)
+{
+    ProtobufCArena *arena = get_arena(allocator);
+
+    return arena ? arena->scratch : 0;
+}
+
+static inline void
+scratch_release(ProtobufCAllocator *allocator, size_t mark)
+{
+    ProtobufCArena *arena = get_arena(allocator);
+
+    if (arena != NULL)
+        arena->scratch = mark;
+}
+
 /* === buffer-simple === */
 
 void
@@ -2582,10 +2686,16 @@ parse_required_member(ScannedMember *scanned_member,
             do_free(allocator, bd->data);
         }
         if (len - pref_len > 0) {
-            bd->data = do_alloc(allocator, len - pref_len);
-            if (bd->data == NULL)
-                return FALSE;
-            memcpy(bd->data, data + pref_len, len - pref_len);
+            ProtobufCArena *arena = get_arena(allocator);
+
+            if (arena != NULL && arena->bytes_in_place) {
+                bd->data = (uint8_t *) data + pref_len;
+            } else {
+                bd->data = do_alloc(allocator, len - pref_len);
+                if (bd->data == NULL)
+                    return FALSE;
+                memcpy(bd->data, data + pref_len, len - pref_len);
+            }
         } else {
             bd->data = NULL;
         }
@@ -3029,7 +3139,9 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
     if (allocator == NULL)
         allocator = &protobuf_c__allocator;
 
-    ScannedMember * first_member_slab = do_alloc(allocator, ( (1UL << FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2)*sizeof(ScannedMember) ) );
+    size_t scratch = scratch_mark(allocator);
+
+    ScannedMember * first_member_slab = scratch_alloc(allocator, ( (1UL << FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2)*sizeof(ScannedMember) ) );
     if (!first_member_slab)
         return (NULL);
 
@@ -3041,10 +3153,11 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
      * first_member_slab), above. All subsequent slabs will be allocated
      * using the allocator.
      */
-    ScannedMember **scanned_member_slabs = do_alloc(allocator, (MAX_SCANNED_MEMBER_SLAB + 1) * sizeof(ScannedMember *) );
+    ScannedMember **scanned_member_slabs = scratch_alloc(allocator, (MAX_SCANNED_MEMBER_SLAB + 1) * sizeof(ScannedMember *) );
     if(!scanned_member_slabs)
     {
-        do_free(allocator, first_member_slab);
+        scratch_free(allocator, first_member_slab);
+        scratch_release(allocator, scratch);
         return NULL;
     }
 
@@ -3059,11 +3172,12 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
     unsigned i_slab;
     unsigned last_field_index = 0;
     unsigned required_fields_bitmap_len;
-    unsigned char * required_fields_bitmap_stack = do_alloc(allocator, 16*sizeof(unsigned char) );
+    unsigned char * required_fields_bitmap_stack = scratch_alloc(allocator, 16*sizeof(unsigned char) );
     if (!required_fields_bitmap_stack)
     {
-        do_free(allocator, first_member_slab);
-        do_free(allocator, scanned_member_slabs);
+        scratch_free(allocator, first_member_slab);
+        scratch_free(allocator, scanned_member_slabs);
+        scratch_release(allocator, scratch);
         return (NULL);
     }
 
@@ -3077,22 +3191,24 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
     rv = do_alloc(allocator, desc->sizeof_message);
     if (!rv)
     {
-        do_free(allocator, required_fields_bitmap_stack);
-        do_free(allocator, first_member_slab);
-        do_free(allocator, scanned_member_slabs);
+        scratch_free(allocator, required_fields_bitmap_stack);
+        scratch_free(allocator, first_member_slab);
+        scratch_free(allocator, scanned_member_slabs);
 
+        scratch_release(allocator, scratch);
         return (NULL);
     }
     scanned_member_slabs[0] = first_member_slab;
 
     required_fields_bitmap_len = (desc->n_fields + 7) / 8;
-    if (required_fields_bitmap_len > sizeof(required_fields_bitmap_stack)) {
-        required_fields_bitmap = do_alloc(allocator, required_fields_bitmap_len);
+    if (required_fields_bitmap_len > 16) {
+        required_fields_bitmap = scratch_alloc(allocator, required_fields_bitmap_len);
         if (!required_fields_bitmap) {
-            do_free(allocator, required_fields_bitmap_stack);
-            do_free(allocator, first_member_slab);
-            do_free(allocator, scanned_member_slabs);
+            scratch_free(allocator, required_fields_bitmap_stack);
+            scratch_free(allocator, first_member_slab);
+            scratch_free(allocator, scanned_member_slabs);
             do_free(allocator, rv);
+            scratch_release(allocator, scratch);
             return (NULL);
         }
         required_fields_bitmap_alloced = TRUE;
@@ -3218,7 +3334,7 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
             which_slab++;
             size = sizeof(ScannedMember)
                 << (which_slab + FIRST_SCANNED_MEMBER_SLAB_SIZE_LOG2);
-            scanned_member_slabs[which_slab] = do_alloc(allocator, size);
+            scanned_member_slabs[which_slab] = scratch_alloc(allocator, size);
             if (scanned_member_slabs[which_slab] == NULL)
                 goto error_cleanup_during_scan;
         }
@@ -3319,34 +3435,37 @@ protobuf_c_message_unpack(const ProtobufCMessageDescriptor *desc,
 
     /* cleanup */
     for (j = 1; j <= which_slab; j++)
-        do_free(allocator, scanned_member_slabs[j]);
+        scratch_free(allocator, scanned_member_slabs[j]);
     if (required_fields_bitmap_alloced)
-        do_free(allocator, required_fields_bitmap);
-    do_free(allocator, required_fields_bitmap_stack);
-    do_free(allocator, first_member_slab);
-    do_free(allocator, scanned_member_slabs);
+        scratch_free(allocator, required_fields_bitmap);
+    scratch_free(allocator, required_fields_bitmap_stack);
+    scratch_free(allocator, first_member_slab);
+    scratch_free(allocator, scanned_member_slabs);
+    scratch_release(allocator, scratch);
     return rv;
 
 error_cleanup:
     protobuf_c_message_free_unpacked(rv, allocator);
     for (j = 1; j <= which_slab; j++)
-        do_free(allocator, scanned_member_slabs[j]);
+        scratch_free(allocator, scanned_member_slabs[j]);
     if (required_fields_bitmap_alloced)
-        do_free(allocator, required_fields_bitmap);
-    do_free(allocator, required_fields_bitmap_stack);
-    do_free(allocator, first_member_slab);
-    do_free(allocator, scanned_member_slabs);
+        scratch_free(allocator, required_fields_bitmap);
+    scratch_free(allocator, required_fields_bitmap_stack);
+    scratch_free(allocator, first_member_slab);
+    scratch_free(allocator, scanned_member_slabs);
+    scratch_release(allocator, scratch);
     return NULL;
 
 error_cleanup_during_scan:
     do_free(allocator, rv);
     for (j = 1; j <= which_slab; j++)
-        do_free(allocator, scanned_member_slabs[j]);
+        scratch_free(allocator, scanned_member_slabs[j]);
     if (required_fields_bitmap_alloced)
-        do_free(allocator, required_fields_bitmap);
-    do_free(allocator, required_fields_bitmap_stack);
-    do_free(allocator, first_member_slab);
-    do_free(allocator, scanned_member_slabs);
+        scratch_free(allocator, required_fields_bitmap);
+    scratch_free(allocator, required_fields_bitmap_stack);
+    scratch_free(allocator, first_member_slab);
+    scratch_free(allocator, scanned_member_slabs);
+    scratch_release(allocator, scratch);
     return NULL;
 }
 
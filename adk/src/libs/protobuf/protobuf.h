@@ -191,6 +191,20 @@ size_t foo__bar__baz_bah__pack_to_buffer
  *
  * The result of unpacking a message should be freed with
  * protobuf_c_message_free_unpacked().
+ *
+ * Alternatively, a message can be unpacked into a single caller supplied block
+ * of memory by passing the allocator of a ProtobufCArena. Nothing is allocated
+ * from the heap, and the whole message is released at once with
+ * protobuf_c_arena_reset():
+ *
+~~~{.c}
+ProtobufCArena arena;
+
+protobuf_c_arena_init(&arena, block, sizeof(block), TRUE);
+msg = foo__bar__baz_bah__unpack(&arena.allocator, len, data);
+...
+protobuf_c_arena_reset(&arena);
+~~~
  */
 
 #ifndef PROTOBUF_C_H
@@ -346,6 +360,7 @@ typedef enum {
 } ProtobufCWireType;
 
 struct ProtobufCAllocator;
+struct ProtobufCArena;
 struct ProtobufCBinaryData;
 struct ProtobufCBuffer;
 struct ProtobufCBufferSimple;
@@ -362,6 +377,7 @@ struct ProtobufCService;
 struct ProtobufCServiceDescriptor;
 
 typedef struct ProtobufCAllocator ProtobufCAllocator;
+typedef struct ProtobufCArena ProtobufCArena;
 typedef struct ProtobufCBinaryData ProtobufCBinaryData;
 typedef struct ProtobufCBuffer ProtobufCBuffer;
 typedef struct ProtobufCBufferSimple ProtobufCBufferSimple;
@@ -398,6 +414,39 @@ struct ProtobufCAllocator {
     void		*allocator_data;
 };
 
+/**
+ * Allocator that carves an unpacked message out of a single block of memory.
+ *
+ * Memory for the message grows up from the start of the block. The scratch
+ * space used while unpacking grows down from the end of the block, and is
+ * given back when protobuf_c_message_unpack() returns. Freeing individual
+ * objects does nothing, so the whole message is released with
+ * protobuf_c_arena_reset().
+ *
+ * If `bytes_in_place` is set, `bytes` fields of the unpacked message point
+ * into the serialised input instead of being copied. The input must then
+ * outlive the message. `string` fields are always copied, as they must be
+ * NUL terminated.
+ *
+ * \see protobuf_c_arena_init
+ */
+struct ProtobufCArena {
+    /** Allocator to pass to protobuf_c_message_unpack(). */
+    ProtobufCAllocator	allocator;
+    /** Start of the block. */
+    uint8_t		*block;
+    /** Size of the block in bytes. */
+    size_t		size;
+    /** Bytes used by the unpacked message. */
+    size_t		used;
+    /** Start of the scratch space. */
+    size_t		scratch;
+    /** Offset of the most recent allocation. */
+    size_t		last;
+    /** Point `bytes` fields into the serialised input. */
+    protobuf_c_boolean	bytes_in_place;
+};
+
 /**
  * Structure for the protobuf `bytes` scalar type.
  *
@@ -981,6 +1030,36 @@ protobuf_c_message_free_unpacked(
     ProtobufCMessage *message,
     ProtobufCAllocator *allocator);
 
+/**
+ * Initialise an arena allocator over a block of memory.
+ *
+ * \param arena
+ *      The arena to initialise.
+ * \param block
+ *      Memory to unpack into. It must be suitably aligned for any type.
+ * \param size
+ *      Size of `block` in bytes.
+ * \param bytes_in_place
+ *      TRUE to leave `bytes` fields pointing into the serialised input.
+ */
+PROTOBUF_C__API
+void
+protobuf_c_arena_init(
+    ProtobufCArena *arena,
+    void *block,
+    size_t size,
+    protobuf_c_boolean bytes_in_place);
+
+/**
+ * Release everything allocated from an arena, so it can be reused.
+ *
+ * \param arena
+ *      The arena to reset.
+ */
+PROTOBUF_C__API
+void
+protobuf_c_arena_reset(ProtobufCArena *arena);
+
 /**
  * Check the validity of a message object.
  *
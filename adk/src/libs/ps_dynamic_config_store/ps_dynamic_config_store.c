@@ -14,6 +14,7 @@ DESCRIPTION
 #include <ps_dynamic_config_store.h>
 #include <config_data.h>
 #include <ps.h>
+#include <message.h>
 #include <stdlib.h>
 #include <panic.h>
 #include <csrtypes.h>
@@ -29,11 +30,20 @@ DESCRIPTION
 #define USED_PS_KEYS_OFFSET(ps_key)     (ps_key / SINGLE_PS_KEY_ITEM_BITS)
 #define USED_PS_KEYS_BIT(ps_key)        ((uint16)(1 << (ps_key % SINGLE_PS_KEY_ITEM_BITS)))
 
+/* Newly used PS keys are recorded in the Used PS keys key after this delay,
+   so that a burst of config writes only rewrites it once. */
+#define USED_PS_KEYS_FLUSH_DELAY_MS     (1000)
+
+/* Internal message to write the Used PS keys key */
+#define PS_DYNAMIC_CONFIG_INTERNAL_FLUSH_USED_PS_KEYS   (0)
+
 
 static uint16 resolvePSKey(const void *const_config_data, config_blk_id_t id);
 static bool initUsedPsKeysPsKey(void);
 static bool getPsKeyUsedState(uint16 ps_key);
 static dynamic_config_status_t setPsKeyUsedState(uint16 ps_key, bool used);
+static dynamic_config_status_t writeUsedPsKeys(void);
+static void psDynamicConfigHandleMessage(Task task, MessageId id, Message message);
 
 
 /* Private PS Dynamic Config Store Data */
@@ -41,11 +51,14 @@ typedef struct __ps_dynamic_config_store_data
 {
     uint16 used_ps_keys_key;                /* Number of PS key which keeps the informations about used ps keys */
     uint16 used_ps_keys[USED_PS_KEYS_SIZE]; /* Information about used ps keys */
+    bool used_ps_keys_dirty;                /* used_ps_keys has changes not yet written to the PS store */
 } ps_dynamic_config_store_data_t;
 
 
 static ps_dynamic_config_store_data_t *psDynamicConfigStore;
 
+static TaskData psDynamicConfigTask = { psDynamicConfigHandleMessage };
+
 
 
 /******************************************************************************/
@@ -56,6 +69,7 @@ dynamic_config_status_t DynamicConfigInit(const void *const_config_data)
 
     psDynamicConfigStore = PanicUnlessMalloc(sizeof(ps_dynamic_config_store_data_t));
     memset(psDynamicConfigStore->used_ps_keys, 0, (USED_PS_KEYS_SIZE * sizeof(uint16)));
+    psDynamicConfigStore->used_ps_keys_dirty = FALSE;
 
 
     config_blk_data = GET_PS_CONFIG_SET_DATA_PTR(const_config_data);
@@ -221,6 +235,12 @@ NAME
  
 DESCRIPTION
     Function that sets given ps key as used or unused.
+
+    The Used PS keys key is only rewritten if the state changes. Marking a
+    key as used is written after USED_PS_KEYS_FLUSH_DELAY_MS, together with
+    any other keys marked in the meantime. Marking a key as unused is written
+    straight away, as a stale used bit would make a removed config block
+    read back as an empty one rather than its default.
  
 PARAMS
     ps_key PS key number.
@@ -231,17 +251,58 @@ RETURNS
 */
 static dynamic_config_status_t setPsKeyUsedState(uint16 ps_key, bool used)
 {
-    uint16 written_data_size;
+    uint16 *used_ps_keys = &psDynamicConfigStore->used_ps_keys[USED_PS_KEYS_OFFSET(ps_key)];
+    uint16 new_used_ps_keys;
 
     if(used)
     {
-        psDynamicConfigStore->used_ps_keys[USED_PS_KEYS_OFFSET(ps_key)] |= USED_PS_KEYS_BIT(ps_key);
+        new_used_ps_keys = *used_ps_keys | USED_PS_KEYS_BIT(ps_key);
     }
     else
     {
-        psDynamicConfigStore->used_ps_keys[USED_PS_KEYS_OFFSET(ps_key)] &= ~USED_PS_KEYS_BIT(ps_key);
+        new_used_ps_keys = *used_ps_keys & ~USED_PS_KEYS_BIT(ps_key);
+    }
+
+    if(new_used_ps_keys == *used_ps_keys)
+    {
+        return dynamic_config_success;
+    }
+
+    *used_ps_keys = new_used_ps_keys;
+
+    if(!used)
+    {
+        return writeUsedPsKeys();
     }
 
+    if(!psDynamicConfigStore->used_ps_keys_dirty)
+    {
+        psDynamicConfigStore->used_ps_keys_dirty = TRUE;
+        MessageSendLater(&psDynamicConfigTask, PS_DYNAMIC_CONFIG_INTERNAL_FLUSH_USED_PS_KEYS, NULL, USED_PS_KEYS_FLUSH_DELAY_MS);
+    }
+
+    return dynamic_config_success;
+}
+
+
+/***************************************************************************
+NAME
+    writeUsedPsKeys
+ 
+DESCRIPTION
+    Function that writes the Used PS keys key and cancels any pending
+    delayed write.
+
+RETURNS
+    dynamic_config_success if everything was OK, error code otherwise.
+*/
+static dynamic_config_status_t writeUsedPsKeys(void)
+{
+    uint16 written_data_size;
+
+    MessageCancelAll(&psDynamicConfigTask, PS_DYNAMIC_CONFIG_INTERNAL_FLUSH_USED_PS_KEYS);
+    psDynamicConfigStore->used_ps_keys_dirty = FALSE;
+
     written_data_size = PsStore(psDynamicConfigStore->used_ps_keys_key, psDynamicConfigStore->used_ps_keys, USED_PS_KEYS_SIZE);
     if(written_data_size != USED_PS_KEYS_SIZE)
     {
@@ -252,6 +313,27 @@ static dynamic_config_status_t setPsKeyUsedState(uint16 ps_key, bool used)
 }
 
 
+/***************************************************************************
+NAME
+    psDynamicConfigHandleMessage
+ 
+DESCRIPTION
+    Message handler for the delayed write of the Used PS keys key.
+*/
+static void psDynamicConfigHandleMessage(Task task, MessageId id, Message message)
+{
+    UNUSED(task);
+    UNUSED(message);
+
+    if(id == PS_DYNAMIC_CONFIG_INTERNAL_FLUSH_USED_PS_KEYS && psDynamicConfigStore->used_ps_keys_dirty)
+    {
+        /* Nothing more can be done if this fails, the newly used keys
+           will read back as their defaults after a reboot. */
+        writeUsedPsKeys();
+    }
+}
+
+
 /***************************************************************************
 NAME
     getPsKeyUsedState
@@ -274,7 +356,6 @@ static bool getPsKeyUsedState(uint16 ps_key)
 dynamic_config_status_t DynamicConfigResetToDefaults(void)
 {
     uint16 ps_key;
-    uint16 data_size;
 
     for (ps_key = 0; USED_PS_KEYS_OFFSET(ps_key) < USED_PS_KEYS_SIZE; ps_key++)
     {
@@ -285,8 +366,7 @@ dynamic_config_status_t DynamicConfigResetToDefaults(void)
         }
     }
 
-    data_size = PsStore(psDynamicConfigStore->used_ps_keys_key, psDynamicConfigStore->used_ps_keys, USED_PS_KEYS_SIZE);
-    if (data_size != USED_PS_KEYS_SIZE)
+    if (writeUsedPsKeys() != dynamic_config_success)
     {
         /* At this point the used ps keys in the ps store does not match the
            ps keys actually in use and could lead to a config block using 
@@ -296,3 +376,14 @@ dynamic_config_status_t DynamicConfigResetToDefaults(void)
 
     return dynamic_config_success;
 }
+
+/***************************************************************************/
+dynamic_config_status_t DynamicConfigFlush(void)
+{
+    if (psDynamicConfigStore && psDynamicConfigStore->used_ps_keys_dirty)
+    {
+        return writeUsedPsKeys();
+    }
+
+    return dynamic_config_success;
+}
@@ -29,6 +29,7 @@ static ppg_t s_ppg_info;
 static ppg_driver_sensor_data_t ppg_data;
 static imu_driver_sensor_data_t  imu_d_data;
 static imu_ppg_data_t imu_ppg_data;
+static imu_range_cache_t imu_range_cache;
 static uint16 IMU_DRIVER_LP_SAMPLE_INTERVAL_MS_TABLE[IMU_NUM_LOW_POWER_ODR] = IMU_SUPPORTED_LOW_POWER_ODR;
 static uint16 PPG_SAMPLE_RATE_TABLE[PPG_NUM_SAMPLE_RATE] = PPG_SPO2_SAMPLE_RATE;
 static uint16 IMU_SETTLE_TIME_TABLE[NUM_IMU_RATES] = IMU_SETTLE_TIME_LOOK_UP;
@@ -687,89 +688,107 @@ static IMU_DRIVER_RETURN_FUNCTION_TYPE imu_gyro_config_update(uint8 v_range,uint
     return com_rslt;
 }
 /**
- * @brief  This function (API) is used to read the data from FIFO.
- *         If there is an update in accelerometer configuration,
- *         the data is flushed from FIFO following the read based on
- *         input_config_frame type .
+ * @brief  This function reads back the range and output data rate of
+ *         the sensors used by imu_mode and keeps them in imu_range_cache.
+ *         The cache is dropped whenever the configuration is changed, so
+ *         the registers are only read on the first FIFO read after that.
  *
- * @param  p_imu_sensor_data IMU sensor data
  * @param  imu_mode Configured IMU Mode (ACCEL/GYRO/BOTH)
  * @return  DRIVER_SUCCESS/Failure (0/1)
  */
-static IMU_DRIVER_RETURN_FUNCTION_TYPE imu_read_fifo_header_mode_data(imu_sensor_data_t *p_imu_sensor_data, imu_mode_t imu_mode)
+static IMU_DRIVER_RETURN_FUNCTION_TYPE imu_update_range_cache(imu_mode_t imu_mode)
 {
-    uint16 v_fifo_length = IMU_DRIVER_INIT_VALUE;
     uint8 v_data  =  IMU_DRIVER_INIT_VALUE;
     IMU_DRIVER_RETURN_FUNCTION_TYPE com_rslt = IMU_DRIVER_INIT_VALUE;
 
-    /** Initialise the sensor data structure before the next fetch */
-    imu_d_sensor_data_init(p_imu_sensor_data);
-    switch(imu_mode)
+    imu_range_cache.accel_range = 0;
+    imu_range_cache.accel_sampling_interval = 0;
+    imu_range_cache.gyro_range = 0;
+    imu_range_cache.gyro_sampling_interval = 0;
+
+    if ((imu_mode == ACCEL_ONLY) || (imu_mode == ACCEL_GYRO_BOTH))
     {
-    case ACCEL_ONLY:
-        imu_d_data.accel.frame_count = 0;
-        imu_d_data.accel.p_imu_data = *(p_imu_sensor_data->accel.data.p_imu_data);
         com_rslt += imu_get_accel_range(&v_data);
         s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
         switch(v_data)
         {
         case IMU_DRIVER_ACCEL_RANGE0:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE0;
+            imu_range_cache.accel_range = IMU_DRIVER_ACCEL_FULL_RANGE0;
             break;
         case IMU_DRIVER_ACCEL_RANGE1:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE1;
+            imu_range_cache.accel_range = IMU_DRIVER_ACCEL_FULL_RANGE1;
             break;
         case IMU_DRIVER_ACCEL_RANGE2:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE2;
+            imu_range_cache.accel_range = IMU_DRIVER_ACCEL_FULL_RANGE2;
             break;
         case IMU_DRIVER_ACCEL_RANGE3:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE3;
+            imu_range_cache.accel_range = IMU_DRIVER_ACCEL_FULL_RANGE3;
             break;
         }
         com_rslt += imu_get_accel_output_data_rate(&v_data);
         s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
-        p_imu_sensor_data->accel.sampling_interval = IMU_DRIVER_LP_SAMPLE_INTERVAL_MS_TABLE[v_data - IMU_ACCEL_OUTPUT_DATA_RATE_OFFSET];
-        break;
-    case GYRO_ONLY:
-        imu_d_data.gyro.frame_count = 0;
-        imu_d_data.gyro.p_imu_data = *(p_imu_sensor_data->gyro.data.p_imu_data);
+        imu_range_cache.accel_sampling_interval = IMU_DRIVER_LP_SAMPLE_INTERVAL_MS_TABLE[v_data - IMU_ACCEL_OUTPUT_DATA_RATE_OFFSET];
+    }
+    if ((imu_mode == GYRO_ONLY) || (imu_mode == ACCEL_GYRO_BOTH))
+    {
         com_rslt += imu_get_gyro_range(&v_data);
         s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
-        p_imu_sensor_data->gyro.range = (v_data << IMU_DRIVER_ACCEL_FULL_RANGE_SHIFT);
+        imu_range_cache.gyro_range = (v_data << IMU_DRIVER_ACCEL_FULL_RANGE_SHIFT);
         com_rslt += imu_get_gyro_output_data_rate(&v_data);
         s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
-        p_imu_sensor_data->gyro.sampling_interval = IMU_DRIVER_LP_SAMPLE_INTERVAL_MS_TABLE[v_data];
+        imu_range_cache.gyro_sampling_interval = IMU_DRIVER_LP_SAMPLE_INTERVAL_MS_TABLE[v_data];
+    }
+    /** Try again on the next read if the sensor didn't answer */
+    imu_range_cache.valid = com_rslt? FALSE : TRUE;
+    imu_range_cache.imu_mode = imu_mode;
+
+    return com_rslt;
+}
+/**
+ * @brief  This function (API) is used to read the data from FIFO.
+ *         If there is an update in accelerometer configuration,
+ *         the data is flushed from FIFO following the read based on
+ *         input_config_frame type .
+ *
+ * @param  p_imu_sensor_data IMU sensor data
+ * @param  imu_mode Configured IMU Mode (ACCEL/GYRO/BOTH)
+ * @return  DRIVER_SUCCESS/Failure (0/1)
+ */
+static IMU_DRIVER_RETURN_FUNCTION_TYPE imu_read_fifo_header_mode_data(imu_sensor_data_t *p_imu_sensor_data, imu_mode_t imu_mode)
+{
+    uint16 v_fifo_length = IMU_DRIVER_INIT_VALUE;
+    IMU_DRIVER_RETURN_FUNCTION_TYPE com_rslt = IMU_DRIVER_INIT_VALUE;
+
+    /** Initialise the sensor data structure before the next fetch */
+    imu_d_sensor_data_init(p_imu_sensor_data);
+    if (!imu_range_cache.valid || (imu_range_cache.imu_mode != imu_mode))
+    {
+        com_rslt += imu_update_range_cache(imu_mode);
+    }
+    switch(imu_mode)
+    {
+    case ACCEL_ONLY:
+        imu_d_data.accel.frame_count = 0;
+        imu_d_data.accel.p_imu_data = *(p_imu_sensor_data->accel.data.p_imu_data);
+        p_imu_sensor_data->accel.range = imu_range_cache.accel_range;
+        p_imu_sensor_data->accel.sampling_interval = imu_range_cache.accel_sampling_interval;
+        break;
+    case GYRO_ONLY:
+        imu_d_data.gyro.frame_count = 0;
+        imu_d_data.gyro.p_imu_data = *(p_imu_sensor_data->gyro.data.p_imu_data);
+        p_imu_sensor_data->gyro.range = imu_range_cache.gyro_range;
+        p_imu_sensor_data->gyro.sampling_interval = imu_range_cache.gyro_sampling_interval;
+        break;
     case ACCEL_GYRO_BOTH:
         imu_d_data.accel.frame_count = 0;
         imu_d_data.accel.p_imu_data = *(p_imu_sensor_data->accel.data.p_imu_data);
         imu_d_data.gyro.frame_count = 0;
         imu_d_data.gyro.p_imu_data = *(p_imu_sensor_data->gyro.data.p_imu_data);
-        com_rslt += imu_get_accel_range(&v_data);
-        s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
-        switch(v_data)
-        {
-        case IMU_DRIVER_ACCEL_RANGE0:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE0;
-            break;
-        case IMU_DRIVER_ACCEL_RANGE1:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE1;
-            break;
-        case IMU_DRIVER_ACCEL_RANGE2:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE2;
-            break;
-        case IMU_DRIVER_ACCEL_RANGE3:
-            p_imu_sensor_data->accel.range = IMU_DRIVER_ACCEL_FULL_RANGE3;
-            break;
-        }
-        com_rslt += imu_get_accel_output_data_rate(&v_data);
-        s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
-        p_imu_sensor_data->accel.sampling_interval = IMU_DRIVER_LP_SAMPLE_INTERVAL_MS_TABLE[v_data - IMU_ACCEL_OUTPUT_DATA_RATE_OFFSET];
-        com_rslt += imu_get_gyro_range(&v_data);
-        s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
-        p_imu_sensor_data->gyro.range = (v_data << IMU_DRIVER_ACCEL_FULL_RANGE_SHIFT);
-        com_rslt += imu_get_gyro_output_data_rate(&v_data);
-        s_imu_info.delay_msec(IMU_DRIVER_GEN_READ_WRITE_DELAY);
-        p_imu_sensor_data->gyro.sampling_interval = IMU_DRIVER_LP_SAMPLE_INTERVAL_MS_TABLE[v_data];
+        p_imu_sensor_data->accel.range = imu_range_cache.accel_range;
+        p_imu_sensor_data->accel.sampling_interval = imu_range_cache.accel_sampling_interval;
+        p_imu_sensor_data->gyro.range = imu_range_cache.gyro_range;
+        p_imu_sensor_data->gyro.sampling_interval = imu_range_cache.gyro_sampling_interval;
+        break;
     case IMU_MODE_NONE:
         break;
     }
@@ -822,6 +841,7 @@ void imu_ppg_data_init(void)
     imu_ppg_data.motion_detect_info = IMU_NO_MOTION;
     imu_ppg_data.ppg_in_out_status = PPG_STATUS_OUT;
     imu_ppg_data.ppg_in_out_status_old = PPG_STATUS_OUT;
+    imu_range_cache.valid = FALSE;
 }
 /**
  *	@brief This function is initialize function for imu device
@@ -1037,6 +1057,7 @@ void imu_handle_config_req(const IMU_CONFIG_REQ_T *req)
     SPORT_HEALTH_DRIVER_DEBUG_INFO(("IMUPPG Task: Receiving IMU_CONFIG_REQ"));
 
     imu_ppg_data.imu_mode_info = req->imu_mode;
+    imu_range_cache.valid = FALSE;
     switch(req->imu_mode)
     {
     case ACCEL_ONLY:
@@ -1066,6 +1087,7 @@ void imu_handle_config_update_req(const IMU_CONFIG_UPDATE_REQ_T *req)
 {
     IMU_DRIVER_RETURN_FUNCTION_TYPE com_rslt = IMU_DRIVER_INIT_VALUE;
 
+    imu_range_cache.valid = FALSE;
     switch(req->imu_mode)
     {
     case ACCEL_ONLY:
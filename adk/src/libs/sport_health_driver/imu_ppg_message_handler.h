@@ -108,6 +108,20 @@ typedef struct{
     uint8 ppg_in_out_status;
     uint8 ppg_in_out_status_old;
 }imu_ppg_data_t;
+/**!
+*	@brief imu range cache
+*	Accel/gyro range and sampling interval as last read back from bmi160.
+*	They only change with the sensor configuration, so FIFO reads use
+*	this copy instead of reading the registers every time.
+*/
+typedef struct{
+    bool valid;
+    imu_mode_t imu_mode;
+    uint16 accel_range;
+    uint8 accel_sampling_interval;
+    uint16 gyro_range;
+    uint8 gyro_sampling_interval;
+}imu_range_cache_t;
 
 /**
  *	@brief This function is used for setting the multi led IR only mode.
@@ -23,8 +23,13 @@ static const uint8 sh_log_compress_bits_z[SH_LOG_MAX_FORMAT_CODE] = {  9,  10, 1
 #define ABS(X) ((X)>=0?(X):(-(X)))
 #endif
 
+/* Number of delta width levels per axis: under 2^9, under 2^10 and under 2^11.
+   Deltas of 2^11 or more can never be compressed */
+#define SH_LOG_BITS_MIN 9
+#define SH_LOG_NUM_LEVELS 3
+
 static uint8 sh_log_bits_to_format(sh_log_compress_imu_info* info);
-static void sh_log_increment_bits_used(const imu_sensor_data_t * p_data, sh_log_compress_imu_info* info);
+static void sh_log_choose_bits_used(const imu_sensor_data_t * p_data, sh_log_compress_imu_info* info);
 
 
 /* Given how many bits are used for each axis determine the format code */
@@ -42,54 +47,58 @@ uint8 sh_log_bits_to_format(sh_log_compress_imu_info* info)
 	return SH_LOG_MAX_FORMAT_CODE;
 }
 
-/* look over the provided sample data counting the number of which would fail compression due to each axis
-   then increment that axis that causes the most fails by one bit thereby doubling its range
+/* Return the smallest level whose width can compress the delta, or SH_LOG_NUM_LEVELS if none can */
+static uint8 sh_log_delta_level(int16 delta)
+{
+	uint16 magnitude = (uint16)ABS(delta);
+	uint8 level = 0;
+	while (level < SH_LOG_NUM_LEVELS && magnitude >= (1 << (SH_LOG_BITS_MIN + level))) {
+		level++;
+	}
+	return level;
+}
+
+/* Pick the format that compresses the most samples.
+   One pass over the samples builds a histogram of the levels each sample needs on all three axes.
+   A sample compresses only if all three axes fit, so the histogram is joint rather than per axis.
+   Each format's compressed count is then summed from the histogram. As every compressed sample
+   saves the same 2 bytes, the format with the most compressed samples gives the smallest payload.
+   Ties go to the lowest format code.
 */
-void sh_log_increment_bits_used(const imu_sensor_data_t * p_data, sh_log_compress_imu_info* info) 
+void sh_log_choose_bits_used(const imu_sensor_data_t * p_data, sh_log_compress_imu_info* info) 
 {
-	uint8 n, count_x, count_y, count_z;
-	int16 prev_x=0, prev_y=0, prev_z=0, x, y, z;
-    uint16 xlimit = (1 << info->bits_x);
-    uint16 ylimit = (1 << info->bits_y);
-    uint16 zlimit = (1 << info->bits_z);
+	uint16 histogram[SH_LOG_NUM_LEVELS][SH_LOG_NUM_LEVELS][SH_LOG_NUM_LEVELS] = {{{0}}};
+	uint16 n, best_count = 0, count;
+	uint8 format, best_format = 0, lx, ly, lz;
     int16* p_imu_data = *(p_data->accel.data.p_imu_data);
-    if (p_data->accel.frame_count == 0) {
-        return;
-    }
-	count_x = count_y = count_z = 0;
-	prev_x = p_imu_data[0];
-	prev_y = p_imu_data[1];
-	prev_z = p_imu_data[2];
+
 	for (n = 1; n < p_data->accel.frame_count; n++) {
-		x = p_imu_data[n*XYZ_SIZE + 0];
-		y = p_imu_data[n*XYZ_SIZE + 1];
-		z = p_imu_data[n*XYZ_SIZE + 2];
-		if (ABS(x - prev_x) > xlimit) {
-            count_x++;
-        }
-		if (ABS(y - prev_y) > ylimit) {
-            count_y++;
-        }
-		if (ABS(z - prev_z) > zlimit)  {
-            count_z++;
-        }
-		prev_x = x;
-		prev_y = y;
-		prev_z = z;
-	}
-    /* Depending on which axis had the most overflows, increase the bit width used on that axis */
-	if (count_x >= count_y && count_x >= count_z)
-	{
-		(info->bits_x)++;
-	}
-	else if (count_y >= count_x && count_y >= count_z)
-	{
-		(info->bits_y)++;
+		lx = sh_log_delta_level(p_imu_data[n*XYZ_SIZE + 0] - p_imu_data[(n - 1)*XYZ_SIZE + 0]);
+		ly = sh_log_delta_level(p_imu_data[n*XYZ_SIZE + 1] - p_imu_data[(n - 1)*XYZ_SIZE + 1]);
+		lz = sh_log_delta_level(p_imu_data[n*XYZ_SIZE + 2] - p_imu_data[(n - 1)*XYZ_SIZE + 2]);
+		if (lx < SH_LOG_NUM_LEVELS && ly < SH_LOG_NUM_LEVELS && lz < SH_LOG_NUM_LEVELS) {
+			histogram[lx][ly][lz]++;
+		}
 	}
-	else
-	{
-		(info->bits_z)++;
+
+	for (format = 0; format < SH_LOG_MAX_FORMAT_CODE; format++) {
+		count = 0;
+		for (lx = 0; lx <= sh_log_compress_bits_x[format] - SH_LOG_BITS_MIN; lx++) {
+			for (ly = 0; ly <= sh_log_compress_bits_y[format] - SH_LOG_BITS_MIN; ly++) {
+				for (lz = 0; lz <= sh_log_compress_bits_z[format] - SH_LOG_BITS_MIN; lz++) {
+					count += histogram[lx][ly][lz];
+				}
+			}
+		}
+		if (count > best_count) {
+			best_count = count;
+			best_format = format;
+		}
 	}
+
+	info->bits_x = sh_log_compress_bits_x[best_format];
+	info->bits_y = sh_log_compress_bits_y[best_format];
+	info->bits_z = sh_log_compress_bits_z[best_format];
 }
 
 /* given the imu data determine the payload (serialized header information to be sent over BLE)
@@ -116,11 +125,9 @@ uint8 SportHealthLoggingCompressImuHeader(const imu_sensor_data_t * p_data, sh_l
 	info->n_bytes_remaining = 0;
 	info->num_packets = 0;
 	info->packet_number = 0;
-	info->bits_x = info->bits_y = info->bits_z = 9;
 
-	/* set the number of bits to be used for each dimension - call the function twice as up to 11 bits may be needed */
-	sh_log_increment_bits_used(p_data, info);
-	sh_log_increment_bits_used(p_data, info);
+	/* set the number of bits to be used for each dimension */
+	sh_log_choose_bits_used(p_data, info);
     /* Now work out the compression format */
 	format_bits = sh_log_bits_to_format(info);
     uint16 xlimit = (1 << info->bits_x);
@@ -105,8 +105,8 @@ uint8 SportHealthLoggingDecompressImuData  (imu_sensor_data_t * p_data, sh_log_d
     }
 	info->last_packet_received = expected_packet_number;
 
-	/* append data into an array */
-	if (payload[1] > GATT_LOGGING_PAYLOAD_SIZE_BYTES) {
+	/* append data into an array. The packet length includes the 2 byte packet header */
+	if (payload[1] > GATT_LOGGING_TOTAL_PACKET_SIZE) {
         return 0;
     }
 
@@ -175,16 +175,18 @@ int8 sh_log_compare_data(const imu_sensor_data_t * p_data, const imu_sensor_data
 {
 	int8 chk, chkx, chky, chkz;
     int n;
+    const int16* p_imu_data = *(p_data->accel.data.p_imu_data);
+    const int16* p_imu_data_ref = *(p_data_ref->accel.data.p_imu_data);
 	chk = 1;
-	chk &= (p_data->accel.last_sample_time == p_data_ref->last_sample_time);
-	chk &= (p_data->accel.frame_count == p_data_ref->frame_count);
-	chk &= (p_data->accel.range == p_data_ref->range);
-	chk &= (p_data->accel.sampling_interval == p_data_ref->sampling_interval);
+	chk &= (p_data->accel.last_sample_time == p_data_ref->accel.last_sample_time);
+	chk &= (p_data->accel.frame_count == p_data_ref->accel.frame_count);
+	chk &= (p_data->accel.range == p_data_ref->accel.range);
+	chk &= (p_data->accel.sampling_interval == p_data_ref->accel.sampling_interval);
 	if (chk == 0) return chk;
 	for (n = 0; n < p_data->accel.frame_count; n++) {
-		chkx = (p_data->accel.data.p_imu_data[n*XYZ_SIZE + 0] == p_data_ref->accel.data.p_imu_data[n*XYZ_SIZE + 0]);
-		chky = (p_data->accel.data.p_imu_data[n*XYZ_SIZE + 1] == p_data_ref->accel.data.p_imu_data[n*XYZ_SIZE + 1]);
-		chkz = (p_data->accel.data.p_imu_data[n*XYZ_SIZE + 2] == p_data_ref->accel.data.p_imu_data[n*XYZ_SIZE + 2]);
+		chkx = (p_imu_data[n*XYZ_SIZE + 0] == p_imu_data_ref[n*XYZ_SIZE + 0]);
+		chky = (p_imu_data[n*XYZ_SIZE + 1] == p_imu_data_ref[n*XYZ_SIZE + 1]);
+		chkz = (p_imu_data[n*XYZ_SIZE + 2] == p_imu_data_ref[n*XYZ_SIZE + 2]);
 		chk = chk & chkx & chky & chkz;
 	}
 	return chk;
@@ -198,34 +200,40 @@ int8 sh_log_test_compression(imu_sensor_data_t * p_data) {
 	static uint8 payload[GATT_LOGGING_TOTAL_PACKET_SIZE];   /* storage for 1 packets worth of data */
 	uint8 imu_err;                       /* result from compression/uncompression algorithms */
 	uint8 ok;                                        /* final validation result */
-	static sh_log_compress_info compress_info;              /* info about how far through the compression we are */
-	static sh_log_decompress_info decompress_info;          /* info about decompression obtained from header */
+	static sh_log_compress_imu_info compress_info;          /* info about how far through the compression we are */
+	static sh_log_decompress_imu_info decompress_info;      /* info about decompression obtained from header */
 	static imu_sensor_data_t decompressed_imu_data;         /* storage for the final unzipped data */
-	static int16 decompress_sample_buffer[MAX_SAMPLES * 6]; /* create storage for unzipped result */
+	static int16 decompress_sample_buffer[SH_LOG_COMPRESS_MAX_SAMPLES * XYZ_SIZE]; /* create storage for unzipped result */
+	static int16 *p_decompress_sample_buffer = decompress_sample_buffer;
     int n;
-	decompressed_imu_data.accel.data.p_imu_data = decompress_sample_buffer;  /* attach the sample buffer to the struct */
+	decompressed_imu_data.accel.data.p_imu_data = &p_decompress_sample_buffer;  /* attach the sample buffer to the struct */
 
-	imu_err = imu_compress_header(p_data, &compress_info, payload);
-	imu_err = imu_uncompress_header(&decompressed_imu_data, &decompress_info, payload);
+	imu_err = SportHealthLoggingCompressImuHeader(p_data, &compress_info, payload);
+	if (imu_err == 0) {
+		printf("encode/decode: not compressible: timestamp = %u\n", (unsigned)p_data->accel.last_sample_time);
+		return 0;
+	}
+	imu_err = SportHealthLoggingDecompressImuHeader(&decompressed_imu_data, &decompress_info, payload);
 
-	for (n = 0; n < zip_info.num_packets; n++) {
-		imu_err = imu_compress_data(p_data, &compress_info, payload);
+	for (n = 0; n < compress_info.num_packets; n++) {
+		imu_err = SportHealthLoggingCompressImuData(p_data, &compress_info, payload);
 
-		// payload would be sent over the air.  We assume that we receive it and call imu_uncompress_data
-		// Note we also know on the receiving side how many packets to expect (uzip_info). 
-		imu_err = imu_uncompress_data(&decompressed_imu_data, &decompress_info, payload);
+		// payload would be sent over the air.  We assume that we receive it and call SportHealthLoggingDecompressImuData
+		// Note we also know on the receiving side how many packets to expect (decompress_info). 
+		imu_err = SportHealthLoggingDecompressImuData(&decompressed_imu_data, &decompress_info, payload);
 	}
+	UNUSED(imu_err);
 
-	ok = validate_data_transfer(&decompressed_imu_data, p_data);
+	ok = sh_log_compare_data(&decompressed_imu_data, p_data);
 
 	if (ok) {
 		// add one to include the header packet in the calculation
-	//	printf("encode/decode successful: compression acheieved = %.1f%%[%d->%d]\n",
-	//		100.0 - (((float)100 * (zip_info.num_packets+1)) / (zip_info.num_packets_uncompressed+1)),
-	//		(zip_info.num_packets_uncompressed+1), (zip_info.num_packets+1));
+		printf("encode/decode successful: compression achieved = %.1f%%[%d->%d]\n",
+			100.0 - (((float)100 * (compress_info.num_packets+1)) / (compress_info.num_packets_uncompressed+1)),
+			(compress_info.num_packets_uncompressed+1), (compress_info.num_packets+1));
 	}
 	else {
-		printf("encode/decode: FAILED: timestamp = %d\n", p_data->accel.last_sample_time);
+		printf("encode/decode: FAILED: timestamp = %u\n", (unsigned)p_data->accel.last_sample_time);
 	}
 
 	return ok;
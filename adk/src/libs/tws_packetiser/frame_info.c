@@ -27,7 +27,8 @@ FILE NAME
     Returns true if a historic match is found. */
 static bool frameInfoFromHistorySBC(const uint8 *sbc, frame_info_t *frame_info, frame_info_history_sbc_t *history)
 {
-    if (history && (sbc[1] == history->last_header1) && (sbc[2] == history->last_header2))
+    if (history && history->valid &&
+        (sbc[1] == history->last_header1) && (sbc[2] == history->last_header2))
     {
         *frame_info = history->frame_info;
         return TRUE;
@@ -40,6 +41,7 @@ static void frameInfoUpdateHistorySBC(const uint8 *sbc, frame_info_t *frame_info
 {
     if (history)
     {
+        history->valid = TRUE;
         history->last_header1 = sbc[1];
         history->last_header2 = sbc[2];
         history->frame_info = *frame_info;
@@ -23,9 +23,12 @@ typedef struct __frame_info
 } frame_info_t;
 
 /*! Store previous SBC header and resulting frame_info to avoid performing the same
-    calculations on repeated frames having the same header */
+    calculations on repeated frames having the same header.
+    A zero initialised history is empty. */
 typedef struct __frame_info_history_sbc
 {
+    /*! TRUE once frame_info has been calculated for a header */
+    bool valid;
     /*! The previous value of the SBC header[0] */
     uint8 last_header1;
     /*! The previous value of the SBC header[1] */
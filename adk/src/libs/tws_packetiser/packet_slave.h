@@ -28,11 +28,13 @@ typedef struct __packet_slave packet_slave_t;
   @param packet_buffer Pointer to the buffer from which to read the packet.
   @param packet_len The length of the packet.
   @param config The packetiser configuration.
+  @param history The SBC frame info history, kept by the packetiser between packets.
   @return TRUE on successful initialisation, FALSE otherwise.
 */
 typedef bool packet_slave_init_t(packet_slave_t *packet,
                                  const uint8 *packet_buffer, uint32 packet_len,
-                                 tws_packetiser_slave_config_t *config);
+                                 tws_packetiser_slave_config_t *config,
+                                 frame_info_history_sbc_t *history);
 
 /*!
   @brief Uninitialise a packet slave, freeing any dynamic memory allocated.
@@ -62,7 +62,7 @@ static bool twsPacketReadAudioFrameInfoSBC(tws_packet_slave_t *tp,
                                            frame_info_t *frame_info)
 {
     uint32 unread = twsPacketCalcUnread(tp);
-    return frameInfoSBC(tp->ptr, unread, frame_info, &tp->frame_info_history_sbc);
+    return frameInfoSBC(tp->ptr, unread, frame_info, tp->frame_info_history_sbc);
 }
 
 /* Read frame info for standard aptX. Since aptX is essentially frameless, this
@@ -80,7 +80,8 @@ static bool twsPacketReadAudioFrameInfoAptX(tws_packet_slave_t *tp,
 
 static bool twsPacketSlaveInit(packet_slave_t *packet,
                                const uint8 *packet_buffer, uint32 packet_len,
-                               tws_packetiser_slave_config_t *config)
+                               tws_packetiser_slave_config_t *config,
+                               frame_info_history_sbc_t *history)
 {
     tws_packet_slave_t *tp = &packet->slave.tws;
     if (tp && packet_buffer && packet_len && config)
@@ -90,7 +91,7 @@ static bool twsPacketSlaveInit(packet_slave_t *packet,
         tp->ptr = packet_buffer;
         tp->frames = 0;
         tp->eah_reader = NULL;
-        memset(&tp->frame_info_history_sbc, 0, sizeof(tp->frame_info_history_sbc));
+        tp->frame_info_history_sbc = history;
 
         /* For SBC: the SBC frame header will always be used to determine frame
            length and frame samples. If the frame has an extended audio header
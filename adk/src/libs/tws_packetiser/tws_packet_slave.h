@@ -53,8 +53,8 @@ struct __tws_packet_slave
      */
     uint32 frame_samples;
     
-    /*! Store the frame info history for SBC */
-    frame_info_history_sbc_t frame_info_history_sbc;
+    /*! The packetiser's frame info history for SBC */
+    frame_info_history_sbc_t *frame_info_history_sbc;
 
     /*! Fragmentation is only allowed when configured for particular codecs */
     bool fragmentation_allowed;
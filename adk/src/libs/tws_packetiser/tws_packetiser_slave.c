@@ -57,6 +57,10 @@ struct __tws_packetiser_slave
         first fragment of audio frame. */
     rtime_spadj_mini_t spadj_mini;
 
+    /*! SBC frame info history. This is kept between packets as the SBC
+        header rarely changes during a stream. */
+    frame_info_history_sbc_t frame_info_history_sbc;
+
     /*! Occasionally, a packet with a new ttp will received having previously received incomplete
         fragments of another frame. The fragments will be written in claimed space in the sink.
         The new fragment will need to overwrite the existing data in the claiming space. This variable
@@ -78,6 +82,11 @@ static void handleScmstChange(tws_packetiser_slave_t *tp,
     }
 }
 
+static const packet_slave_functions_t *packet_funcs[] = {
+    [TWS_PACKETISER_SLAVE_MODE_TWS] = &packet_slave_funcs_tws,
+    [TWS_PACKETISER_SLAVE_MODE_TWS_PLUS] = &packet_slave_funcs_tws_plus
+};
+
 static uint8 *sinkGetWriteAddr(tws_packetiser_slave_t *tp, uint32 len)
 {
     Sink sink = tp->config.sink;
@@ -142,16 +151,12 @@ static bool tpReadPacket(tws_packetiser_slave_t *tp)
     audio_frame_metadata_t fmd = {0};
     bool complete;
     rtime_t ttp_wallclock;
-    const packet_slave_functions_t *packet_funcs[] = {
-        [TWS_PACKETISER_SLAVE_MODE_TWS] = &packet_slave_funcs_tws,
-        [TWS_PACKETISER_SLAVE_MODE_TWS_PLUS] = &packet_slave_funcs_tws_plus
-    };
     tws_packet.funcs = packet_funcs[tp->config.mode];
 
     const uint8 *src = SourceMap(tp->config.source);
     uint16 len = SourceBoundary(tp->config.source);
 
-    if (tws_packet.funcs->init(&tws_packet, src, len, &tp->config) &&
+    if (tws_packet.funcs->init(&tws_packet, src, len, &tp->config, &tp->frame_info_history_sbc) &&
         tws_packet.funcs->readHeader(&tws_packet, &ttp_wallclock, &scmst, &complete))
     {
         frame_info_t frame_info;
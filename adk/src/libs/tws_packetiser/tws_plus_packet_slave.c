@@ -16,7 +16,8 @@ FILE NAME
 
 static bool twsPlusPacketSlaveInit(packet_slave_t *packet,
                                    const uint8 *packet_buffer, uint32 packet_len,
-                                   tws_packetiser_slave_config_t *config)
+                                   tws_packetiser_slave_config_t *config,
+                                   frame_info_history_sbc_t *history)
 {
     tws_plus_packet_slave_t *slave = &packet->slave.tws_plus;
     if (slave && packet_buffer && packet_len && config)
@@ -25,7 +26,7 @@ static bool twsPlusPacketSlaveInit(packet_slave_t *packet,
         slave->len = packet_len;
         slave->ptr = packet_buffer;
         slave->frames = 0;
-        memset(&slave->frame_info_history_sbc, 0, sizeof(slave->frame_info_history_sbc));
+        slave->frame_info_history_sbc = history;
 
         if (config->codec == TWS_PACKETISER_CODEC_SBC ||
             config->codec == TWS_PACKETISER_CODEC_APTX)
@@ -139,7 +140,7 @@ static bool twsPlusPacketReadAudioFrameInfo(packet_slave_t *packet, frame_info_t
     tws_plus_packet_slave_t *slave = &packet->slave.tws_plus;
     uint32 unread = twsPlusPacketCalcUnread(slave);
     return (slave->config->codec == TWS_PACKETISER_CODEC_SBC) ?
-        frameInfoSBC(slave->ptr, unread, frame_info, &slave->frame_info_history_sbc) :
+        frameInfoSBC(slave->ptr, unread, frame_info, slave->frame_info_history_sbc) :
         frameInfoAptx(unread, frame_info);
 }
 
@@ -31,8 +31,8 @@ typedef struct
     /*! Number of frames read from the packet */
     uint32 frames;
     
-    /*! Store the frame info history for SBC */
-    frame_info_history_sbc_t frame_info_history_sbc;
+    /*! The packetiser's frame info history for SBC */
+    frame_info_history_sbc_t *frame_info_history_sbc;
 
     /*! The packet slave shares the packetiser's config */
     tws_packetiser_slave_config_t *config;
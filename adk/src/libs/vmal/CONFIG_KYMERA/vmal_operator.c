@@ -19,6 +19,16 @@ DESCRIPTION
 
 #define MIN_RECEIVE_LEN 10
 
+/* Response buffer for messages where the caller doesn't want the response.
+   OperatorMessage() is synchronous, so this can be shared by all calls. */
+static uint16 unused_response[MIN_RECEIVE_LEN];
+
+#ifdef OPERATOR_MESSAGE_MUST_RECEIVE
+/* CSRA68100 currently requires the response length be set */
+#define UNUSED_RESPONSE_LEN MIN_RECEIVE_LEN
+#else
+#define UNUSED_RESPONSE_LEN 0
+#endif
 
 
 Operator VmalOperatorCreate(uint16 cap_id)
@@ -50,25 +60,11 @@ bool VmalOperatorFrameworkEnableSecondProcessor(bool enable)
 bool VmalOperatorMessage(Operator opid, const void * send_msg, uint16 send_len, 
                                         void * recv_msg, uint16 recv_len)
 {
-    void* receive_message = recv_msg;
-    uint16 receive_length = recv_len;
-    bool result;
-    
     if(0 == recv_len)
     {
         /* We always provide a response pointer for the time being */
-        receive_message = PanicUnlessMalloc(MIN_RECEIVE_LEN * sizeof(uint16));
-#ifdef OPERATOR_MESSAGE_MUST_RECEIVE
-        /* CSRA68100 currently requires the response length be set */
-        receive_length = MIN_RECEIVE_LEN;
-#endif
+        return OperatorMessage(opid, (const uint16 *)send_msg, send_len, unused_response, UNUSED_RESPONSE_LEN);
     }
-    
-    result = OperatorMessage(opid, (const uint16 *)send_msg, send_len, (uint16 *)receive_message, receive_length);
-    
-    if(0 == recv_len)
-    {
-        free(receive_message);
-    }
-    return result;
+
+    return OperatorMessage(opid, (const uint16 *)send_msg, send_len, (uint16 *)recv_msg, recv_len);
 }
@@ -62,6 +62,59 @@ extern void ipc_init(void);
 extern void ipc_send(IPC_SIGNAL_ID msg_id, const void *msg,
                      uint16 len_bytes);
 
+/**
+ * Start a batch of IPC sends.  Messages sent until the matching
+ * \c ipc_send_batch_end() are copied into the IPC send buffer as usual but
+ * the IPC interrupt on the other processor is only raised once, when the
+ * outermost batch ends.  Batches may be nested.
+ *
+ * Nothing inside a batch may wait for the other processor: \c ipc_recv(),
+ * and so any trap that blocks on a response, asserts that no batch is open.
+ * Only a full send buffer raises the interrupt before the batch ends, so that
+ * the other processor drains it.
+ *
+ * \ingroup ipc_send
+ */
+extern void ipc_send_batch_start(void);
+
+/**
+ * End a batch of IPC sends started with \c ipc_send_batch_start(), raising
+ * the IPC interrupt if any message was added to the send buffer during the
+ * batch.
+ *
+ * \ingroup ipc_send
+ */
+extern void ipc_send_batch_end(void);
+
+/**
+ * Statistics on the IPC send path
+ *
+ * \ingroup ipc_send
+ */
+typedef struct
+{
+    uint32 msgs_sent;        /**< Messages copied into the IPC send buffer */
+    uint32 msgs_queued;      /**< Messages that had to wait for buffer space */
+    uint32 interrupts_raised;/**< Number of writes to the interproc event */
+    uint16 queue_depth;      /**< Messages currently waiting for buffer space */
+    uint16 max_queue_depth;  /**< High water mark of queue_depth */
+} IPC_SEND_STATS;
+
+/**
+ * Get the IPC send path statistics
+ * @param stats Filled in with the current statistics
+ *
+ * \ingroup ipc_send
+ */
+extern void ipc_send_get_stats(IPC_SEND_STATS *stats);
+
+/**
+ * Reset the IPC send path statistics, apart from the current queue depth
+ *
+ * \ingroup ipc_send
+ */
+extern void ipc_send_reset_stats(void);
+
 /**
  * Non-blocking out-of-band send: creates an \c IPC_TUNNELLED_PRIM_OUTBAND
  * pointing at the supplied payload and submits it via \c ipc_send().
@@ -481,6 +534,9 @@ extern void ipc_send_sched(qid remote_qid, uint16 mi, void *mv);
  * calls themselves, to avoid inadvertently blocking out any current blocking
  * call for a long time.
  *
+ * Must not be called inside an \c ipc_send_batch_start() batch: the request
+ * being waited on may not have been signalled to the other processor yet.
+ *
  * @param msg_id IPC message to receive
  * @param blocking_msg Pointer to pre-allocated space for the expected message,
  * or NULL if the message should be pmalloc'd internally
@@ -92,6 +92,12 @@ typedef struct
     IPC_RECV_CB_QUEUE *recv_cb; /**< Linked list of current receive callbacks */
     IPC_MSG_QUEUE *send_queue; /**< Linked list of messages waiting for send
                                     buffer space */
+    IPC_MSG_QUEUE **send_queue_tail; /**< Link field to append the next
+                                    message to send_queue at */
+    uint16 send_batch_depth; /**< Nesting level of ipc_send_batch_start */
+    bool send_doorbell_pending; /**< A message was sent during a batch but
+                                     the interproc event not yet raised */
+    IPC_SEND_STATS send_stats; /**< Send path statistics */
 #ifdef CHIP_DEF_P1_SQIF_SHALLOW_SLEEP_WA_B_195036
     /** Difference between location of p0 code in flash and p1 code in flash.
      * Used for translating const pointer from p1 to p0
@@ -191,12 +197,15 @@ extern bool ipc_clear_queue(void);
 /**
  * Helper function to place a message on a given IPC_MSG_QUEUE
  *
- * \param pqueue Pointer to the queue to place the message on
+ * \param pqueue Pointer to the queue to place the message on, or to the link
+ * field of any entry in it.  Passing the link field of the last entry makes
+ * the append O(1).
  * \param msg_id The IPC signal
  * \param msg The message body
  * \param len_bytes The message length in bytes
+ * \return The link field of the new (last) entry
  */
-extern void ipc_queue_msg_core(IPC_MSG_QUEUE **pqueue, IPC_SIGNAL_ID msg_id,
+extern IPC_MSG_QUEUE **ipc_queue_msg_core(IPC_MSG_QUEUE **pqueue, IPC_SIGNAL_ID msg_id,
         const void *msg, uint16 len_bytes);
 
 
@@ -4,6 +4,45 @@
 #include "ipc/ipc_private.h"
 
 
+/**
+ * Raise the IPC interrupt on the other processor.
+ *
+ * \note This function must be called with interrupts blocked!
+ */
+static void ipc_send_raise_interrupt(void)
+{
+    ipc_data.send_doorbell_pending = FALSE;
+    /* Raise IPC interrupt.  It doesn't matter what we write */
+    hal_set_reg_interproc_event_1(1);
+    ++ipc_data.send_stats.interrupts_raised;
+}
+
+/**
+ * Open a batch: messages sent until the matching \c ipc_send_batch_leave()
+ * only mark the interrupt as pending.
+ *
+ * \note This function must be called with interrupts blocked!
+ */
+static void ipc_send_batch_enter(void)
+{
+    ++ipc_data.send_batch_depth;
+}
+
+/**
+ * Close a batch, raising the IPC interrupt if this was the outermost batch
+ * and any message was sent during it.
+ *
+ * \note This function must be called with interrupts blocked!
+ */
+static void ipc_send_batch_leave(void)
+{
+    assert(ipc_data.send_batch_depth > 0);
+    if (--ipc_data.send_batch_depth == 0 && ipc_data.send_doorbell_pending)
+    {
+        ipc_send_raise_interrupt();
+    }
+}
+
 /**
  * Sends the supplied message. The caller must check there is enough space in the
  * buffer to send the message.
@@ -21,8 +60,14 @@ static void ipc_send_no_checks(IPC_SIGNAL_ID msg_id, const void *msg, uint16 len
     /* Set the ID on behalf of the caller */
     ((IPC_HEADER *)send)->id = msg_id;
     buf_add_to_front(ipc_data.send, (uint16)len_bytes);
-    /* Raise IPC interrupt.  It doesn't matter what we write */
-    hal_set_reg_interproc_event_1(1);
+    ++ipc_data.send_stats.msgs_sent;
+    if (ipc_data.send_batch_depth)
+    {
+        /* The interrupt is raised once when the batch ends */
+        ipc_data.send_doorbell_pending = TRUE;
+        return;
+    }
+    ipc_send_raise_interrupt();
 }
 
 /**
@@ -83,14 +128,25 @@ static bool ipc_try_send(IPC_SIGNAL_ID msg_id, const void *msg, uint16 len_bytes
 static void ipc_queue_msg(IPC_SIGNAL_ID msg_id, const void *msg,
                                                             uint16 len_bytes)
 {
-    ipc_queue_msg_core(&ipc_data.send_queue, msg_id, msg, len_bytes);
+    if (ipc_data.send_queue == NULL)
+    {
+        ipc_data.send_queue_tail = &ipc_data.send_queue;
+    }
+    ipc_data.send_queue_tail = ipc_queue_msg_core(ipc_data.send_queue_tail,
+                                                  msg_id, msg, len_bytes);
+
+    ++ipc_data.send_stats.msgs_queued;
+    if (++ipc_data.send_stats.queue_depth > ipc_data.send_stats.max_queue_depth)
+    {
+        ipc_data.send_stats.max_queue_depth = ipc_data.send_stats.queue_depth;
+    }
 
     /* Schedule another attempt to send */
     GEN_BG_INT(ipc);
 }
 
-void ipc_queue_msg_core(IPC_MSG_QUEUE **pqueue, IPC_SIGNAL_ID msg_id,
-                        const void *msg, uint16 len_bytes)
+IPC_MSG_QUEUE **ipc_queue_msg_core(IPC_MSG_QUEUE **pqueue, IPC_SIGNAL_ID msg_id,
+                                   const void *msg, uint16 len_bytes)
 {
     IPC_MSG_QUEUE **pnext = pqueue, *new;
     void *mem;
@@ -108,11 +164,17 @@ void ipc_queue_msg_core(IPC_MSG_QUEUE **pqueue, IPC_SIGNAL_ID msg_id,
     memcpy(new->msg, msg, len_bytes);
     new->length_bytes = len_bytes;
     *pnext = new;
+    return &new->next;
 }
 
 bool ipc_clear_queue(void)
 {
     IPC_MSG_QUEUE **pnext = &ipc_data.send_queue;
+    bool cleared = TRUE;
+
+    /* The backlog is drained as a batch, so the other processor is
+     * interrupted once however many messages make it into the buffer */
+    ipc_send_batch_enter();
     while(*pnext != NULL)
     {
         IPC_MSG_QUEUE *msg_entry = *pnext;
@@ -124,15 +186,22 @@ bool ipc_clear_queue(void)
             /* the queue entry and message are in a single pmalloc block, so
              * just one pfree is required */
             pfree(msg_entry);
+            --ipc_data.send_stats.queue_depth;
         }
         else
         {
             /* Ran out of space again... */
-            return FALSE;
+            cleared = FALSE;
+            break;
         }
     }
-    assert(ipc_data.send_queue == NULL);
-    return TRUE;
+    if (cleared)
+    {
+        assert(ipc_data.send_queue == NULL);
+        ipc_data.send_queue_tail = &ipc_data.send_queue;
+    }
+    ipc_send_batch_leave();
+    return cleared;
 }
 
 
@@ -149,6 +218,13 @@ void ipc_send(IPC_SIGNAL_ID msg_id, const void *msg, uint16 len_bytes)
     {
         ipc_send_signal_interproc_event();
         ipc_queue_msg(msg_id, msg, len_bytes);
+        /* The buffer is full, so the other processor must be told to drain it
+         * now even inside a batch: otherwise it never sees the request to
+         * interrupt us back when space frees up */
+        if (ipc_data.send_doorbell_pending)
+        {
+            ipc_send_raise_interrupt();
+        }
     }
     unblock_interrupts();
 
@@ -156,6 +232,37 @@ void ipc_send(IPC_SIGNAL_ID msg_id, const void *msg, uint16 len_bytes)
 
 
 
+void ipc_send_batch_start(void)
+{
+    block_interrupts();
+    ipc_send_batch_enter();
+    unblock_interrupts();
+}
+
+void ipc_send_batch_end(void)
+{
+    block_interrupts();
+    ipc_send_batch_leave();
+    unblock_interrupts();
+}
+
+void ipc_send_get_stats(IPC_SEND_STATS *stats)
+{
+    block_interrupts();
+    *stats = ipc_data.send_stats;
+    unblock_interrupts();
+}
+
+void ipc_send_reset_stats(void)
+{
+    block_interrupts();
+    ipc_data.send_stats.msgs_sent = 0;
+    ipc_data.send_stats.msgs_queued = 0;
+    ipc_data.send_stats.interrupts_raised = 0;
+    ipc_data.send_stats.max_queue_depth = ipc_data.send_stats.queue_depth;
+    unblock_interrupts();
+}
+
 void ipc_send_outband(IPC_SIGNAL_ID msg_id, void *payload,
                                                     uint32 payload_len_bytes)
 {
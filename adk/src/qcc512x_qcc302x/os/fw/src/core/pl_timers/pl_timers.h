@@ -544,6 +544,22 @@ void timers_scheduler_has_awoken(void);
  */
 extern void timer_cancel_all_bg(void);
 
+#ifdef PL_TIMERS_BLOCKED_TIME_STATS
+/**
+ * Get the longest time for which the timer queue operations have kept
+ * interrupts blocked since the last call to
+ * \c timers_reset_max_interrupts_blocked_time()
+ *
+ * \return Worst case interrupt-blocked time in microseconds
+ */
+extern INTERVAL timers_get_max_interrupts_blocked_time(void);
+
+/**
+ * Reset the worst case interrupt-blocked time statistic
+ */
+extern void timers_reset_max_interrupts_blocked_time(void);
+#endif /* PL_TIMERS_BLOCKED_TIME_STATS */
+
 
 #ifdef DESKTOP_TEST_BUILD
 /**
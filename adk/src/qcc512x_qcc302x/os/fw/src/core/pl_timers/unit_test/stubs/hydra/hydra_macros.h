@@ -0,0 +1,11 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for hydra/hydra_macros.h. pl_timers.c needs nothing from
+ * it.
+ */
+#ifndef HYDRA_MACROS_H
+#define HYDRA_MACROS_H
+
+#endif /* HYDRA_MACROS_H */
@@ -0,0 +1,12 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for patch.h. There are no patch points on the host.
+ */
+#ifndef PATCH_H
+#define PATCH_H
+
+#define patch_fn_shared(name) ((void)0)
+
+#endif /* PATCH_H */
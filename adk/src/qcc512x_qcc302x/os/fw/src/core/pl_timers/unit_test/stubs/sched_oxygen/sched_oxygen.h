@@ -0,0 +1,14 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for sched_oxygen/sched_oxygen.h, declaring only the
+ * scheduler and dorm hooks pl_timers.c calls. The test provides them.
+ */
+#ifndef SCHED_OXYGEN_H
+#define SCHED_OXYGEN_H
+
+extern void sched_wakeup_from_timers(void);
+extern void dorm_wake(void);
+
+#endif /* SCHED_OXYGEN_H */
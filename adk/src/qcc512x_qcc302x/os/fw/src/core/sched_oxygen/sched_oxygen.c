@@ -306,6 +306,25 @@ static bool run = FALSE;
  */
 static volatile bool housekeeping = FALSE;
 
+#ifdef SCHED_PROFILING
+/** Scheduler-wide profiling totals */
+static SCHED_PROFILE_SUMMARY profile_summary;
+
+/**
+ * Total time spent in profiled handlers that have completed, including any
+ * handlers nested inside them.  A handler subtracts the growth of this over
+ * its own call to exclude time stolen by higher priority levels.
+ */
+static uint32 profile_nested_time;
+
+/** Context saved by profile_begin() for the matching profile_end() */
+typedef struct
+{
+    TIME start;
+    uint32 nested_time;
+} PROFILE_MARK;
+#endif /* SCHED_PROFILING */
+
 /****************************************************************************
 Private Function Prototypes
 */
@@ -367,6 +386,42 @@ static BGINT *sched_find_bgint(taskid bgint_id)
     return NULL;
 }
 
+#ifdef SCHED_PROFILING
+/**
+ * Note the start of a handler call.  Must be called with interrupts blocked.
+ *
+ * @param mark Context to be passed on to \c profile_end()
+ */
+static void profile_begin(PROFILE_MARK *mark)
+{
+    mark->nested_time = profile_nested_time;
+    mark->start = hal_get_time();
+}
+
+/**
+ * Account for a handler call that has just returned.  Must be called with
+ * interrupts blocked.
+ *
+ * @param mark Context filled in by \c profile_begin()
+ * @param stats Statistics of the handler that was called
+ */
+static void profile_end(const PROFILE_MARK *mark, SCHED_PROFILE_STATS *stats)
+{
+    uint32 elapsed = (uint32)time_sub(hal_get_time(), mark->start);
+    uint32 self = elapsed - (profile_nested_time - mark->nested_time);
+
+    profile_nested_time = mark->nested_time + elapsed;
+
+    ++stats->invocations;
+    stats->total_time += self;
+    if (self > stats->max_time)
+    {
+        stats->max_time = self;
+    }
+}
+
+#endif /* SCHED_PROFILING */
+
 /**
  * Cleanly remove all traces of a bg int from the scheduler's internals before
  * it is deleted.
@@ -670,6 +725,10 @@ static void service_bg_int(BGINT *b, uint16f HighestPriorityLevel)
 {
     if (0 != b->raised)
     {
+#ifdef SCHED_PROFILING
+        PROFILE_MARK mark;
+#endif
+
         if (b->prunable)
         {
             /*
@@ -693,12 +752,18 @@ static void service_bg_int(BGINT *b, uint16f HighestPriorityLevel)
         /* Need to write the appropriate thing for dynamic BG ints */
         PL_PRINT_P1(TR_PL_SCHED_TASK_RUN,
                     "Running bg int 0x%06x\n", b->id);
+#ifdef SCHED_PROFILING
+        profile_begin(&mark);
+#endif
         /* Unlock IRQs and call the handler function for this task */
         unblock_interrupts();
 
         b->handler(b->ppriv);
 
         block_interrupts();
+#ifdef SCHED_PROFILING
+        profile_end(&mark, &b->profile);
+#endif
 
         PL_PRINT_P1(TR_PL_SCHED_TASK_RUN,
                     "Bg int 0x%06x completed\n", b->id);
@@ -774,11 +839,17 @@ static void service_task(TASK *t, uint16f HighestPriorityLevel)
         {
             if (q->first != (MSG *) NULL)
             {
+#ifdef SCHED_PROFILING
+                PROFILE_MARK mark;
+#endif
                 /* Switch to the task */
                 current_id = &t->id;
 
                 PL_PRINT_P1(TR_PL_SCHED_TASK_RUN,
                                 "Running Task 0x%06x\n", t->id);
+#ifdef SCHED_PROFILING
+                profile_begin(&mark);
+#endif
                 /* Unlock IRQs and call the handler function for this
                  * task */
                 unblock_interrupts();
@@ -786,6 +857,9 @@ static void service_task(TASK *t, uint16f HighestPriorityLevel)
                 t->handler(&t->priv);
 
                 block_interrupts();
+#ifdef SCHED_PROFILING
+                profile_end(&mark, &t->profile);
+#endif
 
                 /* check for any casual timer expiry before checking
                  * any more messages and background interrupts. Timers
@@ -924,6 +998,10 @@ static void check_context_switch(uint16f inputPriorityMask)
         /*Prevent unchecked array overflow*/
         assert(HighestPriorityLevel < NUM_PRIORITIES);
 
+#ifdef SCHED_PROFILING
+        ++profile_summary.context_switches;
+#endif
+
         /* This priority level must correspond to at least one real task or
          * bg int */
         if (NULL == tasks_in_priority[HighestPriorityLevel].first &&
@@ -1271,6 +1349,10 @@ static msgid put_allocated_message(qid queueId, MSG *pMessage)
  */
 static void sched_sleep(void)
 {
+#ifdef SCHED_PROFILING
+    TIME start = hal_get_time();
+    uint32 slept;
+#endif
 #if defined (DESKTOP_TEST_BUILD) && defined (SUBSYSTEM_APPS)
 
     TIME next_time;
@@ -1291,6 +1373,20 @@ static void sched_sleep(void)
     enter_shallow_sleep();
 #endif /* DORM_MODULE_PRESENT */
 #endif /* APPS DESKTOP BUILD */
+
+#ifdef SCHED_PROFILING
+    /* Any interrupt handlers that ran on wake-up are counted as sleep; the
+     * background work they queued is accounted when it runs. */
+    slept = (uint32)time_sub(hal_get_time(), start);
+    block_interrupts();
+    ++profile_summary.sleeps;
+    profile_summary.sleep_time += slept;
+    if (slept > profile_summary.max_sleep_time)
+    {
+        profile_summary.max_sleep_time = slept;
+    }
+    unblock_interrupts();
+#endif /* SCHED_PROFILING */
 }
 #endif /* DISABLE_SHALLOW_SLEEP */
 
@@ -2579,6 +2675,70 @@ TASK *sched_find_task(taskid task_id)
     return NULL;
 }
 
+#ifdef SCHED_PROFILING
+bool sched_profile_get_stats(taskid id, SCHED_PROFILE_STATS *stats)
+{
+    const SCHED_PROFILE_STATS *found = NULL;
+
+    block_interrupts();
+    if (id & BG_INT_FLAG_BIT)
+    {
+        BGINT *b = sched_find_bgint(id);
+        if (b != NULL)
+        {
+            found = &b->profile;
+        }
+    }
+    else
+    {
+        TASK *t = sched_find_task(id);
+        if (t != NULL)
+        {
+            found = &t->profile;
+        }
+    }
+    if (found != NULL)
+    {
+        *stats = *found;
+    }
+    unblock_interrupts();
+
+    return found != NULL;
+}
+
+void sched_profile_get_summary(SCHED_PROFILE_SUMMARY *summary)
+{
+    block_interrupts();
+    *summary = profile_summary;
+    unblock_interrupts();
+}
+
+void sched_profile_reset(void)
+{
+    static const SCHED_PROFILE_STATS zero_stats = {0, 0, 0};
+    static const SCHED_PROFILE_SUMMARY zero_summary = {0, 0, 0, 0};
+    uint16f n;
+
+    block_interrupts();
+    for (n = 0; n < NUM_PRIORITIES; ++n)
+    {
+        TASK *t;
+        BGINT *b;
+
+        for (t = tasks_in_priority[n].first; t != NULL; t = t->next)
+        {
+            t->profile = zero_stats;
+        }
+        for (b = bg_ints_in_priority[n].first; b != NULL; b = b->next)
+        {
+            b->profile = zero_stats;
+        }
+    }
+    profile_summary = zero_summary;
+    unblock_interrupts();
+}
+#endif /* SCHED_PROFILING */
+
 /**
  * Tell dorm how long we'd like to sleep.
  */
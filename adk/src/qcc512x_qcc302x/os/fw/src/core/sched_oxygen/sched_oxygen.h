@@ -119,6 +119,41 @@ typedef void (*MSG_FLUSH_HANDLER)(unsigned int msg_int, void* pmsg_body);
 
 /*@}*/
 
+#ifdef SCHED_PROFILING
+/**
+ * \name Scheduler profiling.
+ */
+/*@{*/
+/**
+ * Run-time accounting for a single task or bg int handler.  Times are in
+ * microseconds and exclude any time spent in handlers at higher priority
+ * levels that pre-empted this one.
+ */
+typedef struct
+{
+    uint32 invocations; /**< Number of times the handler has been called */
+    uint32 total_time;  /**< Cumulative time spent in the handler */
+    uint32 max_time;    /**< Longest single call of the handler */
+} SCHED_PROFILE_STATS;
+
+/**
+ * Scheduler-wide accounting that isn't attributable to a single handler.
+ */
+typedef struct
+{
+    /** Number of times the scheduler switched to a higher priority level */
+    uint32 context_switches;
+    /** Number of times the scheduler went into shallow sleep */
+    uint32 sleeps;
+    /** Cumulative time spent in shallow sleep, in microseconds */
+    uint32 sleep_time;
+    /** Longest single shallow sleep, in microseconds */
+    uint32 max_sleep_time;
+} SCHED_PROFILE_SUMMARY;
+
+/*@}*/
+#endif /* SCHED_PROFILING */
+
 /**
  * \name Autogeneration trickery to create tasks and queues.
  */
@@ -881,6 +916,30 @@ void sched_wakeup_from_timers(void);
  */
 bool sched_get_sleep_deadline(TIME *earliest, TIME *latest);
 
+#ifdef SCHED_PROFILING
+/**
+ * Read the run-time statistics for a task or bg int.
+ *
+ * \param id The task or bg int ID to look up
+ * \param[out] stats Filled in with the statistics for \c id
+ * \return TRUE if \c id is a known task or bg int, FALSE otherwise
+ */
+extern bool sched_profile_get_stats(taskid id, SCHED_PROFILE_STATS *stats);
+
+/**
+ * Read the scheduler-wide statistics.
+ *
+ * \param[out] summary Filled in with the current totals
+ */
+extern void sched_profile_get_summary(SCHED_PROFILE_SUMMARY *summary);
+
+/**
+ * Clear the statistics for every task and bg int and the scheduler-wide
+ * totals.
+ */
+extern void sched_profile_reset(void);
+#endif /* SCHED_PROFILING */
+
 #ifdef DESKTOP_TEST_BUILD
 /*
  * Temporarily set all bg_int handlers to NULL, for the benefit of
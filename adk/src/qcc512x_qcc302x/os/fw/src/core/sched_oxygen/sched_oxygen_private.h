@@ -168,6 +168,9 @@ typedef struct _TASK
 #endif
     unsigned int prunable:1; /**< If this is a dynamic task & can be deleted */
     struct _TASK  *next; /**< Pointer to the next task in a linked list */
+#ifdef SCHED_PROFILING
+    SCHED_PROFILE_STATS profile; /**< Run-time accounting for the handler */
+#endif
 } TASK;
 
 /**
@@ -213,6 +216,10 @@ typedef struct _BGINT {
      * pointer. */
     void                    **ppriv;
     struct _BGINT           *next;
+#ifdef SCHED_PROFILING
+    /** Run-time accounting for the handler */
+    SCHED_PROFILE_STATS     profile;
+#endif
 } BGINT;
 
 typedef struct _UNCOUPLED_BGINT {
@@ -108,6 +108,10 @@ void *ipc_recv(IPC_SIGNAL_ID recv_id, void *blocking_msg)
     /* Purely nominal timeout - it is ignored by dorm_shallow_sleep. */
     TIME latest = time_add(hal_get_time(), SECOND);
 
+    /* The request this call waits on must have reached the other processor:
+     * blocking inside an IPC send batch would wait forever */
+    assert(ipc_data.send_batch_depth == 0);
+
     /* Post the blocking ID to the callback queue with a NULL handler.
      * \c call_msg_callback() will interpret this as indicating the message
      * we're blocking on */
@@ -0,0 +1,174 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for ipc/ipc_private.h, so that ipc_send.c can be built
+ * and run on the host without the rest of the firmware.
+ *
+ * The shared send buffer is modelled as a number of free message slots and
+ * free octets; every message copied into it is recorded so tests can check
+ * what the other processor would see and when it was interrupted.
+ */
+#ifndef IPC_PRIVATE_H_
+#define IPC_PRIVATE_H_
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef unsigned char uint8;
+typedef unsigned short uint16;
+typedef unsigned int uint32;
+typedef signed short int16;
+typedef unsigned char bool;
+
+#ifndef TRUE
+#define TRUE  ((bool)1)
+#define FALSE ((bool)0)
+#endif
+
+typedef enum
+{
+    IPC_SIGNAL_ID_SIGNAL_INTERPROC_EVENT = 1,
+    IPC_SIGNAL_ID_TEST_A,
+    IPC_SIGNAL_ID_TEST_B
+} IPC_SIGNAL_ID;
+
+typedef struct
+{
+    IPC_SIGNAL_ID id;
+} IPC_HEADER;
+
+typedef struct
+{
+    IPC_HEADER header;
+} IPC_SIGNAL;
+
+typedef struct
+{
+    IPC_HEADER header;
+} IPC_SIGNAL_INTERPROC_EVENT_PRIM;
+
+typedef struct
+{
+    IPC_HEADER header;
+    uint32 length;
+    void *payload;
+} IPC_TUNNELLED_PRIM_OUTBAND;
+
+typedef struct
+{
+    IPC_HEADER header;
+    bool ret;
+} IPC_BOOL_RSP;
+
+typedef struct
+{
+    IPC_HEADER header;
+    uint16 ret;
+} IPC_UINT16_RSP;
+
+typedef struct
+{
+    IPC_HEADER header;
+    int16 ret;
+} IPC_INT16_RSP;
+
+/** Statistics on the IPC send path, as in ipc/ipc.h */
+typedef struct
+{
+    uint32 msgs_sent;
+    uint32 msgs_queued;
+    uint32 interrupts_raised;
+    uint16 queue_depth;
+    uint16 max_queue_depth;
+} IPC_SEND_STATS;
+
+/** Largest message the model buffer records */
+#define TEST_IPC_MAX_MSG_BYTES  (32)
+
+/** Number of messages the model buffer records */
+#define TEST_IPC_MAX_MSGS       (64)
+
+typedef struct
+{
+    uint16 free_bytes;
+} TEST_IPC_BUFFER;
+
+typedef struct
+{
+    TEST_IPC_BUFFER buf;
+    uint16 free_msgs;
+    uint8 front[TEST_IPC_MAX_MSG_BYTES];
+    /** IDs of the messages copied into the buffer, in order */
+    IPC_SIGNAL_ID sent_ids[TEST_IPC_MAX_MSGS];
+    uint16 num_sent;
+    /** Value of num_sent each time the other processor was interrupted */
+    uint16 interrupted_at[TEST_IPC_MAX_MSGS];
+    uint16 num_interrupts;
+    uint16 num_bg_ints;
+} BUFFER_MSG;
+
+#define BUF_NUM_MSGS_AVAILABLE(msg_buf) ((msg_buf)->free_msgs)
+#define BUF_GET_FREESPACE(raw_buf)      ((raw_buf)->free_bytes)
+#define buf_map_front_msg(msg_buf)      ((msg_buf)->front)
+
+static inline void buf_add_to_front(BUFFER_MSG *msg_buf, uint16 len)
+{
+    assert(len <= TEST_IPC_MAX_MSG_BYTES);
+    assert(msg_buf->free_msgs && msg_buf->buf.free_bytes >= len);
+    assert(msg_buf->num_sent < TEST_IPC_MAX_MSGS);
+    msg_buf->free_msgs--;
+    msg_buf->buf.free_bytes = (uint16)(msg_buf->buf.free_bytes - len);
+    msg_buf->sent_ids[msg_buf->num_sent++] =
+                                        ((const IPC_HEADER *)msg_buf->front)->id;
+}
+
+typedef struct IPC_MSG_QUEUE
+{
+    struct IPC_MSG_QUEUE *next;
+    IPC_SIGNAL_ID         msg_id;
+    void                 *msg;
+    uint16                length_bytes;
+} IPC_MSG_QUEUE;
+
+/** The parts of the IPC data used by the send path */
+typedef struct
+{
+    BUFFER_MSG *send;
+    IPC_MSG_QUEUE *send_queue;
+    IPC_MSG_QUEUE **send_queue_tail;
+    uint16 send_batch_depth;
+    bool send_doorbell_pending;
+    IPC_SEND_STATS send_stats;
+} IPC_DATA;
+
+extern IPC_DATA ipc_data;
+
+#define hal_set_reg_interproc_event_1(x) \
+    ((void)(x), \
+     ipc_data.send->interrupted_at[ipc_data.send->num_interrupts++] = \
+                                                    ipc_data.send->num_sent)
+#define GEN_BG_INT(x)           (ipc_data.send->num_bg_ints++)
+#define block_interrupts()      ((void)0)
+#define unblock_interrupts()    ((void)0)
+#define pmalloc(size)           malloc(size)
+#define pfree(ptr)              free(ptr)
+
+extern void ipc_send(IPC_SIGNAL_ID msg_id, const void *msg, uint16 len_bytes);
+extern void ipc_send_batch_start(void);
+extern void ipc_send_batch_end(void);
+extern void ipc_send_get_stats(IPC_SEND_STATS *stats);
+extern void ipc_send_reset_stats(void);
+extern void ipc_send_outband(IPC_SIGNAL_ID msg_id, void *payload,
+                             uint32 payload_len_bytes);
+extern void ipc_send_bool(IPC_SIGNAL_ID msg_id, bool val);
+extern void ipc_send_uint16(IPC_SIGNAL_ID msg_id, uint16 val);
+extern void ipc_send_int16(IPC_SIGNAL_ID msg_id, int16 val);
+extern void ipc_send_signal(IPC_SIGNAL_ID sig_id);
+extern bool ipc_clear_queue(void);
+extern IPC_MSG_QUEUE **ipc_queue_msg_core(IPC_MSG_QUEUE **pqueue,
+                                          IPC_SIGNAL_ID msg_id,
+                                          const void *msg, uint16 len_bytes);
+
+#endif /* IPC_PRIVATE_H_ */
@@ -0,0 +1,237 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * DESKTOP_TEST_BUILD tests for the IPC send path: tail append of the back-up
+ * queue, doorbell coalescing in batches and the send statistics.
+ *
+ * Build and run with the Makefile in this directory.
+ */
+
+#include "ipc/ipc_private.h"
+
+#include <stdio.h>
+
+IPC_DATA ipc_data;
+
+static BUFFER_MSG send_buffer;
+
+/** A message of the size of most IPC primitives */
+typedef struct
+{
+    IPC_HEADER header;
+    uint32 value;
+} TEST_MSG;
+
+static void reset(uint16 free_msgs, uint16 free_bytes)
+{
+    while (ipc_data.send_queue)
+    {
+        IPC_MSG_QUEUE *entry = ipc_data.send_queue;
+        ipc_data.send_queue = entry->next;
+        pfree(entry);
+    }
+    memset(&send_buffer, 0, sizeof(send_buffer));
+    memset(&ipc_data, 0, sizeof(ipc_data));
+    send_buffer.free_msgs = free_msgs;
+    send_buffer.buf.free_bytes = free_bytes;
+    ipc_data.send = &send_buffer;
+    ipc_data.send_queue_tail = &ipc_data.send_queue;
+}
+
+static void send_test_msg(IPC_SIGNAL_ID id, uint32 value)
+{
+    TEST_MSG msg;
+    msg.value = value;
+    ipc_send(id, &msg, sizeof(msg));
+}
+
+/** Make room for n more messages, as if the other processor read them */
+static void drain(uint16 n)
+{
+    send_buffer.free_msgs = (uint16)(send_buffer.free_msgs + n);
+    send_buffer.buf.free_bytes = (uint16)(send_buffer.buf.free_bytes +
+                                          n * sizeof(TEST_MSG));
+}
+
+static void test_send_outside_batch_interrupts_each_message(void)
+{
+    IPC_SEND_STATS stats;
+
+    reset(16, 512);
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 1);
+    send_test_msg(IPC_SIGNAL_ID_TEST_B, 2);
+
+    assert(send_buffer.num_sent == 2);
+    assert(send_buffer.num_interrupts == 2);
+    ipc_send_get_stats(&stats);
+    assert(stats.msgs_sent == 2);
+    assert(stats.interrupts_raised == 2);
+    assert(stats.msgs_queued == 0);
+}
+
+static void test_batch_interrupts_once_at_end(void)
+{
+    IPC_SEND_STATS stats;
+    uint32 i;
+
+    reset(16, 512);
+    ipc_send_batch_start();
+    for (i = 0; i < 5; ++i)
+    {
+        send_test_msg(IPC_SIGNAL_ID_TEST_A, i);
+    }
+    assert(send_buffer.num_sent == 5);
+    assert(send_buffer.num_interrupts == 0);
+    ipc_send_batch_end();
+
+    assert(send_buffer.num_interrupts == 1);
+    assert(send_buffer.interrupted_at[0] == 5);
+    ipc_send_get_stats(&stats);
+    assert(stats.msgs_sent == 5);
+    assert(stats.interrupts_raised == 1);
+}
+
+static void test_nested_batch_interrupts_at_outermost_end(void)
+{
+    reset(16, 512);
+    ipc_send_batch_start();
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 0);
+    ipc_send_batch_start();
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 1);
+    ipc_send_batch_end();
+    assert(send_buffer.num_interrupts == 0);
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 2);
+    ipc_send_batch_end();
+
+    assert(send_buffer.num_interrupts == 1);
+    assert(send_buffer.interrupted_at[0] == 3);
+    assert(ipc_data.send_batch_depth == 0);
+}
+
+static void test_empty_batch_does_not_interrupt(void)
+{
+    reset(16, 512);
+    ipc_send_batch_start();
+    ipc_send_batch_end();
+
+    assert(send_buffer.num_interrupts == 0);
+}
+
+static void test_full_buffer_interrupts_inside_batch(void)
+{
+    IPC_SEND_STATS stats;
+
+    /* Room for two messages plus the interproc event signal */
+    reset(3, 2 * sizeof(TEST_MSG) + sizeof(IPC_SIGNAL_INTERPROC_EVENT_PRIM));
+    ipc_send_batch_start();
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 0);
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 1);
+    assert(send_buffer.num_interrupts == 0);
+
+    /* No room: the message is queued and the other processor is told about
+     * everything in the buffer straight away, batch or not */
+    send_test_msg(IPC_SIGNAL_ID_TEST_B, 2);
+    assert(send_buffer.num_sent == 3);
+    assert(send_buffer.sent_ids[2] == IPC_SIGNAL_ID_SIGNAL_INTERPROC_EVENT);
+    assert(send_buffer.num_interrupts == 1);
+    assert(send_buffer.num_bg_ints == 1);
+
+    ipc_send_batch_end();
+    assert(send_buffer.num_interrupts == 1);
+
+    ipc_send_get_stats(&stats);
+    assert(stats.msgs_queued == 1);
+    assert(stats.queue_depth == 1);
+    assert(stats.max_queue_depth == 1);
+}
+
+static void test_clear_queue_keeps_order_and_interrupts_once(void)
+{
+    IPC_SEND_STATS stats;
+    uint32 i;
+
+    reset(0, 0);
+    for (i = 0; i < 4; ++i)
+    {
+        send_test_msg((i & 1) ? IPC_SIGNAL_ID_TEST_B : IPC_SIGNAL_ID_TEST_A, i);
+    }
+    ipc_send_get_stats(&stats);
+    assert(stats.queue_depth == 4);
+    assert(stats.max_queue_depth == 4);
+    assert(send_buffer.num_sent == 0);
+
+    /* The tail points at the link field of the last entry */
+    assert(*ipc_data.send_queue_tail == NULL);
+    assert(ipc_data.send_queue->next->next->next->next == NULL);
+    assert(ipc_data.send_queue_tail == &ipc_data.send_queue->next->next->next->next);
+
+    /* Enough room for the whole backlog and the reserved signal slot */
+    drain(5);
+    assert(ipc_clear_queue());
+
+    assert(send_buffer.num_sent == 4);
+    for (i = 0; i < 4; ++i)
+    {
+        assert(send_buffer.sent_ids[i] ==
+               ((i & 1) ? IPC_SIGNAL_ID_TEST_B : IPC_SIGNAL_ID_TEST_A));
+    }
+    assert(send_buffer.num_interrupts == 1);
+    assert(ipc_data.send_queue == NULL);
+    assert(ipc_data.send_queue_tail == &ipc_data.send_queue);
+
+    ipc_send_get_stats(&stats);
+    assert(stats.queue_depth == 0);
+    assert(stats.max_queue_depth == 4);
+
+    ipc_send_reset_stats();
+    ipc_send_get_stats(&stats);
+    assert(stats.msgs_sent == 0);
+    assert(stats.interrupts_raised == 0);
+    assert(stats.max_queue_depth == 0);
+}
+
+static void test_partial_clear_appends_after_remaining(void)
+{
+    reset(0, 0);
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 0);
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 1);
+    send_test_msg(IPC_SIGNAL_ID_TEST_A, 2);
+
+    /* Room for one message plus the reserved signal slot */
+    drain(2);
+    assert(!ipc_clear_queue());
+    assert(send_buffer.num_sent == 1);
+    assert(send_buffer.num_interrupts == 1);
+
+    /* A new message must still go behind the two left in the queue. The
+     * reserved slot is used to ask the other processor for an interrupt */
+    send_test_msg(IPC_SIGNAL_ID_TEST_B, 3);
+    assert(send_buffer.num_sent == 2);
+    assert(send_buffer.sent_ids[1] == IPC_SIGNAL_ID_SIGNAL_INTERPROC_EVENT);
+    assert(send_buffer.num_interrupts == 2);
+
+    drain(4);
+    assert(ipc_clear_queue());
+
+    assert(send_buffer.num_sent == 5);
+    assert(send_buffer.sent_ids[2] == IPC_SIGNAL_ID_TEST_A);
+    assert(send_buffer.sent_ids[3] == IPC_SIGNAL_ID_TEST_A);
+    assert(send_buffer.sent_ids[4] == IPC_SIGNAL_ID_TEST_B);
+    assert(send_buffer.num_interrupts == 3);
+}
+
+int main(void)
+{
+    test_send_outside_batch_interrupts_each_message();
+    test_batch_interrupts_once_at_end();
+    test_nested_batch_interrupts_at_outermost_end();
+    test_empty_batch_does_not_interrupt();
+    test_full_buffer_interrupts_inside_batch();
+    test_clear_queue_keeps_order_and_interrupts_once();
+    test_partial_clear_appends_after_remaining();
+
+    reset(0, 0);
+    printf("test_ipc_send: all tests passed\n");
+    return 0;
+}
@@ -62,6 +62,32 @@ Private Macro Declarations
  */
 #define LONG_EVENT  (1<<(TIMERID_BIT - 2))
 
+/**
+ * Number of buckets in the casual event timer ID hash table. Must be a power
+ * of two. Timer IDs are allocated sequentially so the low bits spread them
+ * evenly.
+ */
+#define CASUAL_ID_HASH_SIZE 16
+#define CASUAL_ID_HASH(id) ((unsigned int)(id) & (CASUAL_ID_HASH_SIZE - 1))
+
+/**
+ * Access to the casual event heap root and links
+ */
+#define CASUAL_ROOT() \
+    (/*lint -e(1939)*/(tCasualTimerStruct *)casual_events_queue.first_event)
+#define CASUAL_NEXT(event) \
+    (/*lint -e(1939)*/(tCasualTimerStruct *)(event)->base.next)
+
+#ifdef PL_TIMERS_BLOCKED_TIME_STATS
+#define timers_block_interrupts() \
+    do { block_interrupts(); blocked_since = hal_get_time(); } while (0)
+#define timers_unblock_interrupts() \
+    do { record_blocked_time(); unblock_interrupts(); } while (0)
+#else
+#define timers_block_interrupts() block_interrupts()
+#define timers_unblock_interrupts() unblock_interrupts()
+#endif /* PL_TIMERS_BLOCKED_TIME_STATS */
+
 #ifdef DEBUG_KICK_TIMERS
 /* If we set a timer in the past, it immediately expires.
  * Limit how far back it can be.
@@ -166,6 +192,27 @@ static unsigned int short_event_count = MIN_UNIQUE_TIMER_ID_COUNT;
 /** timer id seed counter for longer events */
 static unsigned int long_event_count = MIN_UNIQUE_TIMER_ID_COUNT;
 
+/** Casual events indexed by timer ID */
+static tCasualTimerStruct *casual_id_hash[CASUAL_ID_HASH_SIZE];
+/** Insertion counter used to keep casual events with equal times in order */
+static unsigned int casual_event_seq;
+
+#ifdef PL_TIMERS_BLOCKED_TIME_STATS
+/** Time at which the current timer queue operation blocked interrupts */
+static TIME blocked_since;
+/** Longest time a timer queue operation has kept interrupts blocked */
+static INTERVAL max_blocked_time;
+
+static void record_blocked_time(void)
+{
+    INTERVAL blocked = time_sub(hal_get_time(), blocked_since);
+    if (blocked > max_blocked_time)
+    {
+        max_blocked_time = blocked;
+    }
+}
+#endif /* PL_TIMERS_BLOCKED_TIME_STATS */
+
 /****************************************************************************
 Private Function Definitions
 */
@@ -258,14 +305,12 @@ static TIME get_casual_latest_time(tTimerStruct *event)
  * we can avoid deep sleep-wake overheads. That means finding all timers whose
  * earliest time is due.
  *
- * The list can be sorted only one way. So, either we sort by latest time and
- * make it easy to find the time we want to wake up or we sort by earliest
- * time and make it easy to find timers that we could run.
- *
- * This function controls the sort order.
+ * The heap can be ordered only one way. So, either we order by latest time
+ * and make it easy to find the time we want to wake up or we order by
+ * earliest time and make it easy to find timers that we could run.
  *
- * We can always put in another variable for the other time and then maintain
- * it separately.
+ * We order by latest time, so the root of the heap gives the deep sleep
+ * deadline. Events with equal latest times are kept in insertion order.
  */
 
 /**
@@ -281,6 +326,207 @@ static bool is_casual_event_earlier_than(tTimerStruct *event, TIME event_time)
     return time_le((/*lint -e(1939)*/(tCasualTimerStruct *)event)->latest_time, event_time);
 }
 
+/**
+ * \brief Heap order of casual events
+ *
+ * \return TRUE if \p a must fire no later than \p b
+ */
+static bool casual_event_precedes(const tCasualTimerStruct *a,
+                                  const tCasualTimerStruct *b)
+{
+    if (a->latest_time != b->latest_time)
+    {
+        return time_lt(a->latest_time, b->latest_time);
+    }
+    return (int)(a->seq - b->seq) < 0;
+}
+
+/**
+ * \brief Meld two casual event heaps
+ *
+ * \param[in] a Root of a heap, with no siblings, or NULL
+ * \param[in] b Root of a heap, with no siblings, or NULL
+ *
+ * \return Root of the melded heap
+ */
+static tCasualTimerStruct *casual_heap_meld(tCasualTimerStruct *a,
+                                            tCasualTimerStruct *b)
+{
+    if (a == NULL)
+    {
+        return b;
+    }
+    if (b == NULL)
+    {
+        return a;
+    }
+    if (casual_event_precedes(b, a))
+    {
+        tCasualTimerStruct *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->base.next = (tTimerStruct *)a->child;
+    if (a->child != NULL)
+    {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/**
+ * \brief Combine a list of sibling heaps into one, using the standard two
+ * pass pairing.
+ *
+ * \param[in] first First of the sibling heaps, or NULL
+ *
+ * \return Root of the combined heap
+ */
+static tCasualTimerStruct *casual_heap_merge_pairs(tCasualTimerStruct *first)
+{
+    tCasualTimerStruct *pairs = NULL;
+    tCasualTimerStruct *root = NULL;
+
+    /* Left to right, meld siblings in pairs, stacking the results */
+    while (first != NULL)
+    {
+        tCasualTimerStruct *a = first;
+        tCasualTimerStruct *b = CASUAL_NEXT(a);
+
+        first = (b != NULL) ? CASUAL_NEXT(b) : NULL;
+        a->base.next = NULL;
+        a->prev = NULL;
+        if (b != NULL)
+        {
+            b->base.next = NULL;
+            b->prev = NULL;
+            a = casual_heap_meld(a, b);
+        }
+        a->base.next = (tTimerStruct *)pairs;
+        pairs = a;
+    }
+
+    /* Right to left, meld the pairs into a single heap */
+    while (pairs != NULL)
+    {
+        tCasualTimerStruct *a = pairs;
+
+        pairs = CASUAL_NEXT(a);
+        a->base.next = NULL;
+        root = casual_heap_meld(root, a);
+    }
+    return root;
+}
+
+/**
+ * \brief Add a casual event to the heap and the timer ID index. WARNING!
+ * Interrupts must be locked around a call to this function.
+ *
+ * \param[in] event New event
+ */
+static void add_casual_event(tCasualTimerStruct *event)
+{
+    unsigned int bucket = CASUAL_ID_HASH(event->base.timer_id);
+
+    event->base.next = NULL;
+    event->child = NULL;
+    event->prev = NULL;
+    event->seq = casual_event_seq++;
+    casual_events_queue.first_event =
+                        (tTimerStruct *)casual_heap_meld(CASUAL_ROOT(), event);
+
+    event->id_next = casual_id_hash[bucket];
+    casual_id_hash[bucket] = event;
+}
+
+/**
+ * \brief Remove a casual event from the heap. It is left in the timer ID
+ * index. WARNING! Interrupts must be locked around a call to this function.
+ *
+ * \param[in] event Event to remove
+ */
+static void remove_casual_event_from_heap(tCasualTimerStruct *event)
+{
+    tCasualTimerStruct *sub_heap = casual_heap_merge_pairs(event->child);
+
+    if (event == CASUAL_ROOT())
+    {
+        casual_events_queue.first_event = (tTimerStruct *)sub_heap;
+    }
+    else
+    {
+        tCasualTimerStruct *next = CASUAL_NEXT(event);
+
+        if (event->prev->child == event)
+        {
+            event->prev->child = next;
+        }
+        else
+        {
+            event->prev->base.next = (tTimerStruct *)next;
+        }
+        if (next != NULL)
+        {
+            next->prev = event->prev;
+        }
+        casual_events_queue.first_event =
+                        (tTimerStruct *)casual_heap_meld(CASUAL_ROOT(), sub_heap);
+    }
+    event->base.next = NULL;
+    event->child = NULL;
+    event->prev = NULL;
+}
+
+/**
+ * \brief Remove a casual event from the heap and the timer ID index. WARNING!
+ * Interrupts must be locked around a call to this function.
+ *
+ * \param[in] event Event to remove
+ */
+static void remove_casual_event(tCasualTimerStruct *event)
+{
+    tCasualTimerStruct **pevent =
+                        &casual_id_hash[CASUAL_ID_HASH(event->base.timer_id)];
+
+    while (*pevent != event)
+    {
+        pevent = &(*pevent)->id_next;
+    }
+    *pevent = event->id_next;
+    remove_casual_event_from_heap(event);
+}
+
+/**
+ * \brief Find a casual event by timer ID. WARNING! Interrupts must be locked
+ * around a call to this function.
+ *
+ * Timer IDs can repeat once the ID counters wrap. If more than one event has
+ * the ID, the one due to fire first is returned, as the sorted queue used to.
+ *
+ * \param[in] timer_id Timer ID of the event
+ *
+ * \return The event or NULL if there is no casual event with that ID
+ */
+static tCasualTimerStruct *find_casual_event(tTimerId timer_id)
+{
+    tCasualTimerStruct *event;
+    tCasualTimerStruct *found = NULL;
+
+    for (event = casual_id_hash[CASUAL_ID_HASH(timer_id)]; event != NULL;
+         event = event->id_next)
+    {
+        if (event->base.timer_id == timer_id &&
+            (found == NULL || casual_event_precedes(event, found)))
+        {
+            found = event;
+        }
+    }
+    return found;
+}
+
 /**
  * \brief Function to add a timed event to a queue. WARNING! Interrupts must be
  * locked around a call to this function.
@@ -441,7 +687,7 @@ tTimerId create_add_strict_event(
     new_event->base.timer_id = timer_id;
 
 
-    block_interrupts();
+    timers_block_interrupts();
     /* If this changes the next timer to fire set it before re-enabling
      * the timer hardware */
     if (add_event(&strict_events_queue, &new_event->base))
@@ -452,7 +698,7 @@ tTimerId create_add_strict_event(
         HAL_SET_REG_TIMER1_TRIGGER(event_time);
         hal_set_reg_timer1_en(1);
     }
-    unblock_interrupts();
+    timers_unblock_interrupts();
 
     return timer_id;
 }
@@ -470,7 +716,6 @@ static tTimerId populate_add_casual_event(tCasualTimerStruct *new_event,
             sched_in_interrupt());
 #endif
 
-    new_event->base.next = NULL;
     new_event->base.data_pointer = data_ptr;
     new_event->base.TimedEventFunction = event_fn;
     new_event->earliest_time = earliest;
@@ -478,9 +723,9 @@ static tTimerId populate_add_casual_event(tCasualTimerStruct *new_event,
     new_event->base.timer_id = get_new_timer_id(
                                  CASUAL_EVENT, earliest);
 
-    block_interrupts();
-    (void)add_event(&casual_events_queue, &new_event->base);
-    unblock_interrupts();
+    timers_block_interrupts();
+    add_casual_event(new_event);
+    timers_unblock_interrupts();
     return new_event->base.timer_id;
 }
 
@@ -585,10 +830,8 @@ tTimerId asm_timer_schedule_bg_event_in(
  */
 bool timer_cancel_event_ret(tTimerId timer_id, uint16 *piarg, void **ptask_data)
 {
-    tTimerStruct *cancel_event;
+    tTimerStruct *cancel_event = NULL;
     tTimerStruct **ppCurrentEvent;
-    tEventsQueue *event_queue = NULL;
-    bool event_found = FALSE;
 
     patch_fn_shared(timers_cancel);
 
@@ -598,66 +841,72 @@ bool timer_cancel_event_ret(tTimerId timer_id, uint16 *piarg, void **ptask_data)
         return FALSE;
     }
 
-    block_interrupts();
+    timers_block_interrupts();
     if (EVENT_IS_STRICT(timer_id))
     {
-        event_queue = &strict_events_queue;
         /* About to cancel a strict event. Disable timer */
         hal_set_reg_timer1_en(0);
+
+        ppCurrentEvent = &(strict_events_queue.first_event);
+
+        while (NULL != *ppCurrentEvent)
+        {
+            if ((*ppCurrentEvent)->timer_id == timer_id)
+            {
+                /* Update the list */
+                cancel_event = *ppCurrentEvent;
+                *ppCurrentEvent = cancel_event->next;
+                break;
+            }
+            ppCurrentEvent = &(*ppCurrentEvent)->next;
+        }
+
+        /* If there are still strict events then re-enable timers. The
+         * hardware will fire if they are in the past so don't need to do a
+         * paranoid check. */
+        set_next_hardware_timer();
     }
     else
     {
-        event_queue = &casual_events_queue;
+        tCasualTimerStruct *casual_event = find_casual_event(timer_id);
+
+        if (casual_event != NULL)
+        {
+            remove_casual_event(casual_event);
+            cancel_event = &casual_event->base;
+        }
     }
+    timers_unblock_interrupts();
 
-    ppCurrentEvent = &(event_queue->first_event);
+    if (cancel_event == NULL)
+    {
+        return FALSE;
+    }
 
-    while (NULL != (cancel_event = *ppCurrentEvent))
+    /* If it's an alt event we need to grab the arguments from the alt
+     * storage area */
+    if (cancel_event->TimedEventFunction == alt_handler_wrapper)
     {
-        if (cancel_event->timer_id == timer_id)
+        if (piarg != NULL)
         {
-            /* Update the list */
-            *ppCurrentEvent = cancel_event->next;
-
-            /* Free the timer and return */
-
-            /* If it's an alt event we need to grab the arguments from the alt
-             * storage area */
-            if (cancel_event->TimedEventFunction == alt_handler_wrapper)
-            {
-                if (piarg != NULL)
-                {
-                    *piarg = ((alt_handler_data *)(cancel_event->data_pointer))->iarg;
-                }
-                if (ptask_data != NULL)
-                {
-                    *ptask_data = ((alt_handler_data *)(cancel_event->data_pointer))->task_data;
-                }
-            }
-            else if (ptask_data != NULL)
-            {
-                *ptask_data = cancel_event->data_pointer;
-            }
-
-            /* Note: in the case of alt events we rely on the fact that the
-             * tCasualTimerStruct being deleted here is the first element in
-             * the tAltCasualTimerStruct which was allocated to ensure that
-             * the pfree matches the pnew. */
-            pfree(cancel_event);
-            event_found = TRUE;
-            break;
+            *piarg = ((alt_handler_data *)(cancel_event->data_pointer))->iarg;
+        }
+        if (ptask_data != NULL)
+        {
+            *ptask_data = ((alt_handler_data *)(cancel_event->data_pointer))->task_data;
         }
-        ppCurrentEvent = &(*ppCurrentEvent)->next;
     }
-
-    /* If there are still strict events then re-enable timers. The hardware will
-     * fire if they are in the past so don't need to do a paranoid check. */
-    if (event_queue == &strict_events_queue)
+    else if (ptask_data != NULL)
     {
-        set_next_hardware_timer();
+        *ptask_data = cancel_event->data_pointer;
     }
-    unblock_interrupts();
-    return event_found;
+
+    /* Note: in the case of alt events we rely on the fact that the
+     * tCasualTimerStruct being deleted here is the first element in
+     * the tAltCasualTimerStruct which was allocated to ensure that
+     * the pfree matches the pnew. */
+    pfree(cancel_event);
+    return TRUE;
 }
 
 /*
@@ -669,11 +918,12 @@ void timer_cancel_event_by_function(tTimerEventFunction TimerEventFunction,
 {
     tTimerStruct **ppCurrentEvent;
     tTimerStruct *event;
+    unsigned int bucket;
 
     patch_fn_shared(timers_cancel);
 
     /* Disable timers until the cancel routine completes */
-    block_interrupts();
+    timers_block_interrupts();
     hal_set_reg_timer1_en(0);
 
     ppCurrentEvent = &(strict_events_queue.first_event);
@@ -694,30 +944,34 @@ void timer_cancel_event_by_function(tTimerEventFunction TimerEventFunction,
         ppCurrentEvent = &(*ppCurrentEvent)->next;
     }
 
-    /* Next, search through the casual event queue and remove all casual events with
-     * given event handler */
-    ppCurrentEvent = &(casual_events_queue.first_event);
-
-    /* Loop through the list and cancel all events with given event handler */
-    while (NULL != (event = *ppCurrentEvent))
+    /* Next, search through the casual events and remove all casual events
+     * with given event handler */
+    for (bucket = 0; bucket < CASUAL_ID_HASH_SIZE; bucket++)
     {
-        if ((TimerEventFunction == event->TimedEventFunction) &&
-           ((data_pointer == NULL) || (data_pointer == event->data_pointer)))
+        tCasualTimerStruct **pcasual = &casual_id_hash[bucket];
+        tCasualTimerStruct *casual;
+
+        while (NULL != (casual = *pcasual))
         {
-            /* Found an event with the given function.
-             * Delete and continue search */
-            *ppCurrentEvent = event->next;
-            pfree(event);
-            continue;
+            if ((TimerEventFunction == casual->base.TimedEventFunction) &&
+               ((data_pointer == NULL) ||
+                (data_pointer == casual->base.data_pointer)))
+            {
+                /* Found an event with the given function.
+                 * Delete and continue search */
+                *pcasual = casual->id_next;
+                remove_casual_event_from_heap(casual);
+                pfree(casual);
+                continue;
+            }
+            pcasual = &casual->id_next;
         }
-        /* Go to the next event */
-        ppCurrentEvent = &(*ppCurrentEvent)->next;
     }
 
     /* If there are still strict events then re-enable timers. The hardware will
      * fire if they are in the past so don't need to do a paranoid check. */
     set_next_hardware_timer();
-    unblock_interrupts();
+    timers_unblock_interrupts();
 }
 
 /* Note: the alt interface is only used for casual timers, so we only search
@@ -726,35 +980,39 @@ void timer_cancel_event_by_function_alt(tTimerEventFunctionAlt TimerEventFunctio
                                     uint16 iarg,
                                     void *data_pointer)
 {
-    tTimerStruct **ppCurrentEvent;
-    tTimerStruct *event;
+    unsigned int bucket;
 
-    block_interrupts();
-    /* Search through the casual event queue and remove all casual events with
+    timers_block_interrupts();
+    /* Search through the casual events and remove all casual events with
      * given event handler */
-    ppCurrentEvent = &(casual_events_queue.first_event);
-
-    /* Loop through the list and cancel all events with given event handler */
-    while (NULL != (event = *ppCurrentEvent))
+    for (bucket = 0; bucket < CASUAL_ID_HASH_SIZE; bucket++)
     {
-        if (alt_handler_wrapper == event->TimedEventFunction)
+        tCasualTimerStruct **pcasual = &casual_id_hash[bucket];
+        tCasualTimerStruct *casual;
+
+        while (NULL != (casual = *pcasual))
         {
-            alt_handler_data *hdl_data = (alt_handler_data *)event->data_pointer;
-            if (hdl_data->fn == TimerEventFunction &&
-                iarg == hdl_data->iarg &&
-                ((data_pointer == NULL) || (data_pointer == hdl_data->task_data)))
+            if (alt_handler_wrapper == casual->base.TimedEventFunction)
             {
-                /* Found an event with the given function.
-                 * Delete and continue search */
-                *ppCurrentEvent = event->next;
-                pfree(event);
-                continue;
+                alt_handler_data *hdl_data =
+                            (alt_handler_data *)casual->base.data_pointer;
+                if (hdl_data->fn == TimerEventFunction &&
+                    iarg == hdl_data->iarg &&
+                    ((data_pointer == NULL) ||
+                     (data_pointer == hdl_data->task_data)))
+                {
+                    /* Found an event with the given function.
+                     * Delete and continue search */
+                    *pcasual = casual->id_next;
+                    remove_casual_event_from_heap(casual);
+                    pfree(casual);
+                    continue;
+                }
             }
+            pcasual = &casual->id_next;
         }
-        /* Go to the next event */
-        ppCurrentEvent = &(*ppCurrentEvent)->next;
     }
-    unblock_interrupts();
+    timers_unblock_interrupts();
 }
 
 bool timer_cancel_strict_event_by_function_cmp(
@@ -902,6 +1160,45 @@ void timers_service_expired_strict_events(void)
     }
 }
 
+/**
+ * \brief Find the casual event that should be serviced next
+ *
+ * \return The event with the earliest latest time among those whose earliest
+ * time has passed, or NULL if no casual event is due
+ */
+static tCasualTimerStruct *find_due_casual_event(void)
+{
+    tCasualTimerStruct *root = CASUAL_ROOT();
+    tCasualTimerStruct *due = NULL;
+    TIME now;
+    unsigned int bucket;
+
+    if (NULL == root || !is_current_time_earlier_than(root->earliest_time))
+    {
+        /* Either nothing is queued or the root is due, which is the common
+         * case of earliest == latest */
+        return root;
+    }
+
+    /* Events that are due but aren't the root have earliest < latest */
+    now = hal_get_time();
+    for (bucket = 0; bucket < CASUAL_ID_HASH_SIZE; bucket++)
+    {
+        tCasualTimerStruct *event;
+
+        for (event = casual_id_hash[bucket]; NULL != event;
+             event = event->id_next)
+        {
+            if (time_le(event->earliest_time, now) &&
+                (NULL == due || casual_event_precedes(event, due)))
+            {
+                due = event;
+            }
+        }
+    }
+    return due;
+}
+
 /*
  * NAME
  *   timers_service_expired_casual_events
@@ -909,32 +1206,20 @@ void timers_service_expired_strict_events(void)
 void timers_service_expired_casual_events(void)
 {
     tCasualTimerStruct *event;
-    tTimerStruct **event_pos = &casual_events_queue.first_event;
 
     patch_fn_shared(timers_service);
 
-    while(NULL != (event = /*lint -e(1939)*/(tCasualTimerStruct *) *event_pos))
+    /*
+     * Service due events in the order of their latest times. If we service
+     * an event then the queue may be manipulated so we need to restart our
+     * search from scratch.
+     */
+    while(NULL != (event = find_due_casual_event()))
     {
-        if (!is_current_time_earlier_than(event->earliest_time))
-        {
-            /*
-             * The event has expired. remove and service, noting the expiry
-             * time.
-             *
-             * If we service an event then the queue may be manipulated so we
-             * need to restart our search at the beginning.
-             */
-            *event_pos = event->base.next;
-            casual_events_queue.last_fired = event->earliest_time;
-
-            service_event(&event->base);
-
-            event_pos = &casual_events_queue.first_event;
-        }
-        else
-        {
-            event_pos = &event->base.next;
-        }
+        remove_casual_event(event);
+        casual_events_queue.last_fired = event->earliest_time;
+
+        service_event(&event->base);
     }
 }
 
@@ -1234,57 +1519,58 @@ tTimerId timer_schedule_bg_event_in_between_alt(
 
 bool timer_get_time_of_bg_event(tTimerId timer_id, TIME *event_time)
 {
-    /* Search the casual event queue for the specified timerID.  If it is
+    /* Search the casual events for the specified timerID.  If it is
      * found, return its event_time field. */
 
-    tTimerStruct **ppCurrentEvent, *event;
+    tCasualTimerStruct *event;
 
     block_interrupts();
-    ppCurrentEvent = &(casual_events_queue.first_event);
-
-    while (NULL != (event = *ppCurrentEvent))
+    event = find_casual_event(timer_id);
+    if (NULL != event)
     {
-        if (event->timer_id == timer_id)
-        {
-            /*lint -e1939 Yes, indeed, a downcast */
-            tCasualTimerStruct *casual_event = (tCasualTimerStruct *)event;
-            *event_time = casual_event->earliest_time;
-            unblock_interrupts();
-            return TRUE;
-        }
-        ppCurrentEvent = &event->next;
+        *event_time = event->earliest_time;
     }
     unblock_interrupts();
-    return FALSE;
+    return (NULL != event);
 }
 
 tTimerId timer_find_first_bg_event_by_fn_alt(tTimerEventFunctionAlt fn,
                                              uint16 *piarg,
                                              void **ptask_data)
 {
-    /* Search the casual event queue for the specified timerID.  If it is
-     * found, return its event_time field. */
+    /* Search the casual events for the first to fire of those with the
+     * specified handler and arguments. */
 
-    tTimerStruct **ppCurrentEvent, *event;
+    tCasualTimerStruct *first = NULL;
+    unsigned int bucket;
     tTimerId id = TIMER_ID_INVALID;
 
     block_interrupts();
-    ppCurrentEvent = &(casual_events_queue.first_event);
-
-    while (NULL != (event = *ppCurrentEvent))
+    for (bucket = 0; bucket < CASUAL_ID_HASH_SIZE; bucket++)
     {
-        if (event->TimedEventFunction == alt_handler_wrapper)
+        tCasualTimerStruct *event;
+
+        for (event = casual_id_hash[bucket]; NULL != event;
+             event = event->id_next)
         {
-            alt_handler_data *alt_event = (alt_handler_data *)event->data_pointer;
-            if (alt_event->fn == fn &&
-                    (piarg == NULL || *piarg == alt_event->iarg) &&
-                    (ptask_data == NULL || *ptask_data == alt_event->task_data))
+            if (event->base.TimedEventFunction == alt_handler_wrapper)
             {
-                id = event->timer_id;
-                break;
+                alt_handler_data *alt_event =
+                                (alt_handler_data *)event->base.data_pointer;
+                if (alt_event->fn == fn &&
+                        (piarg == NULL || *piarg == alt_event->iarg) &&
+                        (ptask_data == NULL ||
+                         *ptask_data == alt_event->task_data) &&
+                        (NULL == first || casual_event_precedes(event, first)))
+                {
+                    first = event;
+                }
             }
         }
-        ppCurrentEvent = &event->next;
+    }
+    if (NULL != first)
+    {
+        id = first->base.timer_id;
     }
 
     unblock_interrupts();
@@ -1361,21 +1647,38 @@ void timer_cancel_all_bg(void)
 {
     /* Loop through and cancel all the bg timed events */
 
-    tTimerStruct **ppCurrentEvent, *event;
+    unsigned int bucket;
 
     block_interrupts();
-    ppCurrentEvent = &(casual_events_queue.first_event);
-
-    while (NULL != (event = *ppCurrentEvent))
+    for (bucket = 0; bucket < CASUAL_ID_HASH_SIZE; bucket++)
     {
-        ppCurrentEvent = &event->next;
-        pfree(event);
+        tCasualTimerStruct *event = casual_id_hash[bucket];
+
+        while (NULL != event)
+        {
+            tCasualTimerStruct *next = event->id_next;
+            pfree(event);
+            event = next;
+        }
+        casual_id_hash[bucket] = NULL;
     }
 
     casual_events_queue.first_event = NULL;
     unblock_interrupts();
 }
 
+#ifdef PL_TIMERS_BLOCKED_TIME_STATS
+INTERVAL timers_get_max_interrupts_blocked_time(void)
+{
+    return max_blocked_time;
+}
+
+void timers_reset_max_interrupts_blocked_time(void)
+{
+    max_blocked_time = 0;
+}
+#endif /* PL_TIMERS_BLOCKED_TIME_STATS */
+
 #ifdef UNIT_TEST_BUILD
 /*
  * NAME
@@ -1385,7 +1688,6 @@ void timer_cancel_all_bg(void)
 TIME get_timer_expiry_time(tTimerId timer_id)
 {
     tTimerStruct *event;
-    tEventsQueue *event_queue = NULL;
     if (TIMER_ID_INVALID == timer_id)
     {
         /* invalid timer id. Just return */
@@ -1394,17 +1696,16 @@ TIME get_timer_expiry_time(tTimerId timer_id)
 
     if (EVENT_IS_STRICT(timer_id))
     {
-        event_queue = &strict_events_queue;
+        /* search through the events queue to find the event */
+        for (event = strict_events_queue.first_event;
+             NULL != event && event->timer_id != timer_id; event = event->next);
     }
     else
     {
-        event_queue = &casual_events_queue;
+        tCasualTimerStruct *casual_event = find_casual_event(timer_id);
+        event = (NULL != casual_event) ? &casual_event->base : NULL;
     }
 
-    /* search through the events queue to find the event */
-    for (event = event_queue->first_event;
-         NULL != event && event->timer_id != timer_id; event = event->next);
-
     if (NULL == event)
     {
         /* the event may be being serviced as we speak check this */
@@ -1436,7 +1737,6 @@ TIME get_timer_expiry_time(tTimerId timer_id)
 tTimerStruct *get_timer_from_id(tTimerId timer_id)
 {
     tTimerStruct *event;
-    tEventsQueue *event_queue = NULL;
     if (TIMER_ID_INVALID == timer_id)
     {
         /* invalid timer id. Just return */
@@ -1445,17 +1745,16 @@ tTimerStruct *get_timer_from_id(tTimerId timer_id)
 
     if (EVENT_IS_STRICT(timer_id))
     {
-        event_queue = &strict_events_queue;
+        /* search through the events queue to find the event */
+        for (event = strict_events_queue.first_event;
+             NULL != event && event->timer_id != timer_id; event = event->next);
     }
     else
     {
-        event_queue = &casual_events_queue;
+        tCasualTimerStruct *casual_event = find_casual_event(timer_id);
+        event = (NULL != casual_event) ? &casual_event->base : NULL;
     }
 
-    /* search through the events queue to find the event */
-    for (event = event_queue->first_event;
-         NULL != event && event->timer_id != timer_id; event = event->next);
-
     if (NULL == event)
     {
         /* the event may be being serviced as we speak check this */
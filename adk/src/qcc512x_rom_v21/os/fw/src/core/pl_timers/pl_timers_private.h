@@ -56,12 +56,24 @@ typedef struct
 
 /**
  * Casual timer time values
+ *
+ * Casual timers are kept in a pairing heap ordered by latest time, in which
+ * base.next links an event to its next sibling, and in a hash table indexed
+ * by timer ID.
  */
-typedef struct
+typedef struct tCasualTimerStructTag
 {
     tTimerStruct base;
     TIME earliest_time; /**< Earliest time at which timer expires */
     TIME latest_time; /**< Latest time at which timer expires */
+    struct tCasualTimerStructTag *child; /**< First child in the heap */
+    struct tCasualTimerStructTag *prev; /**< Parent if this is the first child,
+                                             else previous sibling. NULL for
+                                             the root */
+    struct tCasualTimerStructTag *id_next; /**< Next event in the same timer
+                                                ID hash bucket */
+    unsigned int seq; /**< Insertion order, orders events with equal latest
+                           times */
 } tCasualTimerStruct;
 
 
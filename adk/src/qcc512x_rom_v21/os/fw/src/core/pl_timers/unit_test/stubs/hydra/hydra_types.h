@@ -0,0 +1,31 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for hydra/hydra_types.h, so that pl_timers.c can be built
+ * and run on the host without the rest of the firmware.
+ *
+ * UINT_BIT is deliberately short: timer IDs are then only eight bits wide,
+ * so the ID counters wrap after a handful of timers and the tests can make
+ * events that share an ID.
+ */
+#ifndef HYDRA_TYPES_H
+#define HYDRA_TYPES_H
+
+#include <limits.h>
+#include <stddef.h>
+
+typedef unsigned char uint8;
+typedef unsigned short uint16;
+typedef unsigned int uint32;
+typedef signed int int32;
+typedef unsigned char bool;
+
+#ifndef TRUE
+#define TRUE  ((bool)1)
+#define FALSE ((bool)0)
+#endif
+
+#define UINT_BIT 8
+
+#endif /* HYDRA_TYPES_H */
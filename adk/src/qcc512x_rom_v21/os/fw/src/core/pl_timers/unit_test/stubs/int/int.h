@@ -0,0 +1,16 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for int/int.h. The test counts how deeply interrupts are
+ * blocked so it can check every block is matched by an unblock.
+ */
+#ifndef INT_H
+#define INT_H
+
+extern int blocked_interrupts;
+
+#define block_interrupts() ((void)(blocked_interrupts++))
+#define unblock_interrupts() ((void)(blocked_interrupts--))
+
+#endif /* INT_H */
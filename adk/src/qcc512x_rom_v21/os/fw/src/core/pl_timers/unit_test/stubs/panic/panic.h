@@ -0,0 +1,22 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for panic/panic.h. Nothing the tests do should panic, so
+ * a panic is a failed assertion.
+ */
+#ifndef PANIC_H
+#define PANIC_H
+
+#include <assert.h>
+
+typedef enum
+{
+    PANIC_PL_TIMER_NO_HANDLER = 0x1097,
+    PANIC_PL_TIMER_TOO_OLD
+} panicid;
+
+#define panic(id) assert(!"panic")
+#define panic_diatribe(id, arg) assert(!"panic")
+
+#endif /* PANIC_H */
@@ -0,0 +1,35 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for pmalloc/pmalloc.h, on top of the C library heap. The
+ * test counts live blocks so leaks show up.
+ */
+#ifndef PMALLOC_H
+#define PMALLOC_H
+
+#include <assert.h>
+#include <stdlib.h>
+
+extern int pmalloc_blocks;
+
+static inline void *pmalloc_test_alloc(size_t size)
+{
+    void *block = malloc(size);
+    assert(block != NULL);
+    pmalloc_blocks++;
+    return block;
+}
+
+static inline void pfree(void *block)
+{
+    if (block != NULL)
+    {
+        pmalloc_blocks--;
+        free(block);
+    }
+}
+
+#define pnew(type) ((type *)pmalloc_test_alloc(sizeof(type)))
+
+#endif /* PMALLOC_H */
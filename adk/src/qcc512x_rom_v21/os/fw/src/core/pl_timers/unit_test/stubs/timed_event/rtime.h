@@ -0,0 +1,34 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * Desktop stand-in for timed_event/rtime.h. The time arithmetic is the same
+ * as the firmware's; the clock and the timer hardware are faked by the test.
+ */
+#ifndef RTIME_H
+#define RTIME_H
+
+#include "hydra/hydra_types.h"
+
+typedef uint32 TIME;
+typedef int32 INTERVAL;
+
+#define MICROSECOND ((INTERVAL)1)
+#define MILLISECOND (1000L * MICROSECOND)
+#define SECOND      (1000L * MILLISECOND)
+
+#define time_add(t1, t2) ((TIME)(t1) + (TIME)(t2))
+#define time_sub(t1, t2) ((INTERVAL) (t1) - (INTERVAL) (t2))
+#define time_gt(t1, t2) (time_sub((t1), (t2)) > 0)
+#define time_ge(t1, t2) (time_sub((t1), (t2)) >= 0)
+#define time_lt(t1, t2) (time_sub((t1), (t2)) < 0)
+#define time_le(t1, t2) (time_sub((t1), (t2)) <= 0)
+
+/** The test's clock */
+extern TIME hal_get_time(void);
+
+/** The test's model of the strict timer hardware */
+extern void hal_set_reg_timer1_trigger(unsigned time);
+extern void hal_set_reg_timer1_en(unsigned enable);
+
+#endif /* RTIME_H */
@@ -0,0 +1,281 @@
+/* Copyright (c) 2016 Qualcomm Technologies International, Ltd. */
+/*    */
+/**
+ * \file
+ * DESKTOP_TEST_BUILD tests for the casual (background) timed events: adding,
+ * cancelling by timer ID, events that share a timer ID and the order in which
+ * expired events are serviced.
+ *
+ * Build and run with the Makefile in this directory.
+ */
+
+#include "pl_timers/pl_timers_private.h"
+
+#include <stdio.h>
+
+int blocked_interrupts;
+int pmalloc_blocks;
+
+static TIME now;
+
+/** Every handler call is recorded here, as an index into labels */
+#define MAX_FIRED 32
+static int labels[MAX_FIRED];
+static int fired[MAX_FIRED];
+static int num_fired;
+
+TIME hal_get_time(void)
+{
+    return now;
+}
+
+void hal_set_reg_timer1_trigger(unsigned time)
+{
+    (void)time;
+}
+
+void hal_set_reg_timer1_en(unsigned enable)
+{
+    (void)enable;
+}
+
+void sched_wakeup_from_timers(void)
+{
+}
+
+void dorm_wake(void)
+{
+}
+
+static void record(void *data)
+{
+    assert(num_fired < MAX_FIRED);
+    fired[num_fired++] = (int)((int *)data - labels);
+}
+
+static void reset(void)
+{
+    timer_cancel_all_bg();
+    assert(pmalloc_blocks == 0);
+    num_fired = 0;
+    now = 1000;
+}
+
+/** Casual event due exactly \p in microseconds from now, labelled \p label */
+static tTimerId add_at(INTERVAL in, int label)
+{
+    return timer_schedule_bg_event_at(time_add(now, in), record,
+                                      &labels[label]);
+}
+
+/** Move the clock on and service whatever casual events are due */
+static void run_until(INTERVAL in)
+{
+    now = time_add(now, in);
+    block_interrupts();
+    timers_service_expired_casual_events();
+    unblock_interrupts();
+    assert(blocked_interrupts == 0);
+}
+
+static void test_events_fire_in_time_order(void)
+{
+    static const INTERVAL in[] = { 700, 300, 900, 100, 500, 800, 200, 600, 400 };
+    unsigned i;
+    TIME next;
+
+    reset();
+    for (i = 0; i < sizeof(in) / sizeof(in[0]); ++i)
+    {
+        add_at(in[i], (int)(in[i] / 100));
+    }
+    assert(timers_get_next_event_time(&next));
+    assert(next == time_add(now, 100));
+
+    run_until(50);
+    assert(num_fired == 0);
+
+    run_until(350);
+    assert(num_fired == 4);
+
+    run_until(1000);
+    assert(num_fired == 9);
+    for (i = 0; i < 9; ++i)
+    {
+        assert(fired[i] == (int)i + 1);
+    }
+    assert(!timers_get_next_event_time(&next));
+    assert(pmalloc_blocks == 0);
+}
+
+static void test_equal_times_fire_in_order_added(void)
+{
+    reset();
+    add_at(200, 1);
+    add_at(100, 0);
+    add_at(200, 2);
+    add_at(200, 3);
+
+    run_until(200);
+    assert(num_fired == 4);
+    assert(fired[0] == 0);
+    assert(fired[1] == 1);
+    assert(fired[2] == 2);
+    assert(fired[3] == 3);
+}
+
+static void test_due_events_fire_by_latest_time(void)
+{
+    reset();
+    /* Both are due at 200, the one with the earlier deadline goes first */
+    timer_schedule_bg_event_at_between(time_add(now, 100), time_add(now, 400),
+                                       record, &labels[1]);
+    timer_schedule_bg_event_at_between(time_add(now, 200), time_add(now, 250),
+                                       record, &labels[2]);
+
+    run_until(150);
+    assert(num_fired == 1);
+    assert(fired[0] == 1);
+
+    reset();
+    timer_schedule_bg_event_at_between(time_add(now, 100), time_add(now, 400),
+                                       record, &labels[1]);
+    timer_schedule_bg_event_at_between(time_add(now, 200), time_add(now, 250),
+                                       record, &labels[2]);
+
+    run_until(200);
+    assert(num_fired == 2);
+    assert(fired[0] == 2);
+    assert(fired[1] == 1);
+}
+
+static void test_cancel_by_id(void)
+{
+    tTimerId first, second, third;
+    void *data = NULL;
+    TIME when;
+
+    reset();
+    first = add_at(100, 1);
+    second = add_at(200, 2);
+    third = add_at(300, 3);
+    assert(first != second && second != third);
+
+    assert(timer_get_time_of_bg_event(second, &when));
+    assert(when == time_add(now, 200));
+
+    assert(timer_cancel_event_ret(second, NULL, &data));
+    assert(data == &labels[2]);
+    assert(!timer_get_time_of_bg_event(second, &when));
+    assert(!timer_cancel_event_ret(second, NULL, NULL));
+    assert(!timer_cancel_event_ret(TIMER_ID_INVALID, NULL, NULL));
+
+    /* Cancelling the earliest moves the deadline on */
+    timer_cancel_event(first);
+    assert(timers_get_next_event_time(&when));
+    assert(when == time_add(now, 300));
+
+    run_until(1000);
+    assert(num_fired == 1);
+    assert(fired[0] == 3);
+    assert(!timer_cancel_event_ret(third, NULL, NULL));
+    assert(pmalloc_blocks == 0);
+}
+
+/**
+ * Add a casual event labelled \p label, \p in microseconds from now, that
+ * gets the timer ID \p id once the ID counter wraps round to it.
+ */
+static void add_with_id(tTimerId id, INTERVAL in, int label)
+{
+    for (;;)
+    {
+        tTimerId new_id = add_at(in, label);
+
+        if (new_id == id)
+        {
+            return;
+        }
+        timer_cancel_event(new_id);
+    }
+}
+
+static void test_duplicate_id_cancels_earliest_first(void)
+{
+    tTimerId id;
+    void *data = NULL;
+    TIME when;
+
+    /* The one added later is due first */
+    reset();
+    id = add_at(500, 1);
+    add_with_id(id, 100, 2);
+
+    assert(timer_get_time_of_bg_event(id, &when));
+    assert(when == time_add(now, 100));
+    assert(timer_cancel_event_ret(id, NULL, &data));
+    assert(data == &labels[2]);
+
+    /* The one added first is due first */
+    reset();
+    id = add_at(100, 1);
+    add_with_id(id, 500, 2);
+
+    assert(timer_get_time_of_bg_event(id, &when));
+    assert(when == time_add(now, 100));
+    assert(timer_cancel_event_ret(id, NULL, &data));
+    assert(data == &labels[1]);
+    assert(timer_cancel_event_ret(id, NULL, &data));
+    assert(data == &labels[2]);
+    assert(!timer_cancel_event_ret(id, NULL, NULL));
+
+    /* Both are due at once: the one added first goes */
+    reset();
+    id = add_at(300, 1);
+    add_with_id(id, 300, 2);
+
+    assert(timer_cancel_event_ret(id, NULL, &data));
+    assert(data == &labels[1]);
+    run_until(300);
+    assert(num_fired == 1);
+    assert(fired[0] == 2);
+    assert(pmalloc_blocks == 0);
+}
+
+static void test_cancel_by_function(void)
+{
+    reset();
+    add_at(100, 1);
+    add_at(200, 2);
+    add_at(300, 3);
+    timer_schedule_bg_event_at(time_add(now, 150), record, &labels[4]);
+
+    timer_cancel_event_by_function(record, &labels[2]);
+    run_until(1000);
+    assert(num_fired == 3);
+    assert(fired[0] == 1);
+    assert(fired[1] == 4);
+    assert(fired[2] == 3);
+
+    reset();
+    add_at(100, 1);
+    add_at(200, 2);
+    timer_cancel_event_by_function(record, NULL);
+    run_until(1000);
+    assert(num_fired == 0);
+    assert(pmalloc_blocks == 0);
+}
+
+int main(void)
+{
+    test_events_fire_in_time_order();
+    test_equal_times_fire_in_order_added();
+    test_due_events_fire_by_latest_time();
+    test_cancel_by_id();
+    test_duplicate_id_cancels_earliest_first();
+    test_cancel_by_function();
+
+    reset();
+    printf("test_pl_timers: all tests passed\n");
+    return 0;
+}
@@ -944,10 +944,14 @@ bool MessageCancelFirst(Task task, uint16 id)
 uint16 MessageCancelAll(Task task, MessageId id)
 {
     uint16 count = 0;
+    /* Each cancelled BlueStack primitive or stream message is reported to P0,
+     * interrupt it once for all of them */
+    ipc_send_batch_start();
     while (MessageCancelFirst(task, id))
     {
         count++;
     }
+    ipc_send_batch_end();
     return count;
 }
 
@@ -961,6 +965,9 @@ uint16 MessageFlushTask(Task task)
 
     vm_message_forget(task);
 
+    /* Each flushed BlueStack primitive or stream message is reported to P0,
+     * interrupt it once for all of them */
+    ipc_send_batch_start();
     while(*p)
     {
         struct AppMessage *a = *p;
@@ -1007,6 +1014,7 @@ uint16 MessageFlushTask(Task task)
             p = &(*p)->next;
         }
     }
+    ipc_send_batch_end();
     return count;
 }
 
@@ -0,0 +1,28 @@
+# Common settings for the host (DESKTOP_TEST_BUILD) unit tests.
+#
+# A test Makefile sets ADK_SRC to the path of this directory's parent and
+# includes this file, then adds its own include paths to INCPATHS and its
+# sources to SRCS. The code under test is built with the host compiler
+# against the installed firmware headers. stubs/ holds the unity test API
+# and the host versions of firmware headers that don't build cleanly on a
+# 64-bit host.
+
+CHIP_TYPE ?= qcc512x_qcc302x
+OS_INCLUDE = $(ADK_SRC)/$(CHIP_TYPE)/os/installed_libs/include
+HOST_TEST_STUBS = $(ADK_SRC)/unit_test/stubs
+
+CC ?= gcc
+
+CFLAGS += -std=gnu99 -Wall -Werror -Wno-unknown-pragmas -g
+CFLAGS += -DDESKTOP_TEST_BUILD -DDISABLE_LOG
+# The firmware headers rely on these being pre-included by the VM build
+CFLAGS += -include trapsets.h -include csrtypes.h -include hydra_macros.h
+
+# The test's own include paths come first, then the shared stubs, then the
+# firmware and installed library headers
+HOST_TEST_INCPATHS = $(HOST_TEST_STUBS) \
+                     $(OS_INCLUDE)/firmware_$(CHIP_TYPE) \
+                     $(OS_INCLUDE)/standard \
+                     $(ADK_SRC)/installed_libs/include/profiles/default_$(CHIP_TYPE)
+
+HOST_TEST_SRCS = $(HOST_TEST_STUBS)/unity.c
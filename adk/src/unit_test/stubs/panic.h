@@ -0,0 +1,43 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Host stand-in for the firmware panic.h.
+
+            The firmware macros cast integers to and from pointers, which are
+            wider than int on a 64-bit host. These versions go through
+            uintptr_t and evaluate their argument once. The functions are the
+            same traps, each test provides them.
+*/
+
+#ifndef __PANIC_H__
+#define __PANIC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*! Panics the application if the value passed is FALSE. */
+#define PanicFalse PanicZero
+
+/*! Panics the application if the value passed is zero. */
+#define PanicZero(x) \
+    ({ \
+        uintptr_t panic_value_ = (uintptr_t)(x); \
+        if (!panic_value_) \
+            Panic(); \
+        (unsigned int)panic_value_; \
+    })
+
+/*! Panics the application if the value passed is not zero. */
+#define PanicNotZero(x) ((uintptr_t)(x) ? Panic() : (void)0)
+
+/*! Allocates memory equal to the size of T, panics if that fails. */
+#define PanicUnlessNew(T) (T*)PanicUnlessMalloc(sizeof(T))
+
+void Panic(void);
+void *PanicNull(void *pointer);
+void PanicNotNull(const void *pointer);
+void *PanicUnlessMalloc(size_t size);
+
+#endif /* __PANIC_H__ */
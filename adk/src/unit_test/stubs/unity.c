@@ -0,0 +1,27 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      Test counters for the host unity stand-in, and the library
+            functions the firmware headers expect that the host C library
+            does not provide.
+*/
+
+#include <string.h>
+
+int unity_tests;
+int unity_failures;
+
+/* macros.h maps memcpy and memcmp onto the firmware's coal_ functions */
+#undef memcpy
+void *coal_memcpy(void *destination, const void *source, size_t size)
+{
+    return memcpy(destination, source, size);
+}
+
+#undef memcmp
+int coal_memcmp(const void *first, const void *second, size_t size)
+{
+    return memcmp(first, second, size);
+}
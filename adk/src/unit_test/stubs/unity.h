@@ -0,0 +1,52 @@
+/*!
+\copyright  Copyright (c) 2019 Qualcomm Technologies International, Ltd.\n
+            All Rights Reserved.\n
+            Qualcomm Technologies International, Ltd. Confidential and Proprietary.
+\file
+\brief      The part of the unity test API used by the host unit tests.
+*/
+
+#ifndef UNITY_H_
+#define UNITY_H_
+
+#include <stdio.h>
+
+extern int unity_tests;
+extern int unity_failures;
+
+#define TEST_ASSERT(condition) \
+    do { \
+        if (!(condition)) \
+        { \
+            printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, #condition); \
+            unity_failures++; \
+            return; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQUAL(expected, actual) \
+    do { \
+        long expected_value = (long)(expected); \
+        long actual_value = (long)(actual); \
+        if (expected_value != actual_value) \
+        { \
+            printf("%s:%d: FAIL: %s expected %ld was %ld\n", \
+                   __FILE__, __LINE__, #actual, expected_value, actual_value); \
+            unity_failures++; \
+        } \
+    } while (0)
+
+#define UNITY_BEGIN()   (unity_tests = 0, unity_failures = 0)
+
+#define RUN_TEST(test) \
+    do { \
+        unity_tests++; \
+        setUp(); \
+        test(); \
+        tearDown(); \
+    } while (0)
+
+#define UNITY_END() \
+    printf("%d Tests %d Failures\n", unity_tests, unity_failures)
+
+#endif /* UNITY_H_ */
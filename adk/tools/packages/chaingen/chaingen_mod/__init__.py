@@ -30,6 +30,11 @@ class ChainTerminalException(Exception):
     pass
 
 
+class ChainOperatorException(Exception):
+    '''Exception class indicating a problem with the operators in a chain'''
+    pass
+
+
 class ChainGenerator(object):  # pylint: disable=too-many-instance-attributes
     ''' Base chain generator class '''
     def __init__(self, element_tree_root, outfile=None):
@@ -109,6 +114,14 @@ class ChainGenerator(object):  # pylint: disable=too-many-instance-attributes
         ''' The name of the array '''
         return "{}_exclude_from_configure_sample_rate".format(self.chain_name)
 
+    def role_min_name(self, index):
+        ''' The name of the enumerator holding the lowest role of the first index + 1 operators '''
+        return "{}_role_min_{}".format(self.chain_name, index)
+
+    def first_role_name(self):
+        ''' The name of the enumerator holding the lowest operator role in the chain '''
+        return "{}_first_role".format(self.chain_name)
+
 
 class ChainConfigurationGenerator(ChainGenerator):
     ''' Given a xml definition of a chain,
@@ -154,6 +167,34 @@ class ChainConfigurationGenerator(ChainGenerator):
         str_b = "{operator}, {terminal_num}, 1}}".format(**sink_metadata)
         return str_a + str_b
 
+    def check_operator_roles(self):
+        ''' The role index needs every operator role to be unique '''
+        names = [op.attrib['name'] for op in self.operators]
+        duplicates = sorted(set(name for name in names if names.count(name) > 1))
+        if duplicates:
+            raise ChainOperatorException("Operator roles used more than once: {}".format(", ".join(duplicates)))
+        if len(names) > 255:
+            raise ChainOperatorException("{} operators, the role index supports at most 255".format(len(names)))
+
+    def role_index_enum_lines(self):
+        ''' Generate enumerators working out the lowest operator role.
+
+            The role values are only known to the compiler, so the minimum is
+            built up one operator at a time. A nested MIN() macro would do the
+            same but its expansion doubles in size with each operator.
+        '''
+        names = [op.attrib['name'] for op in self.operators]
+        lines = ["{} = {}".format(self.role_min_name(0), names[0])]
+        for i, name in enumerate(names[1:], 1):
+            previous = self.role_min_name(i - 1)
+            lines.append("{} = ({} < {}) ? {} : {}".format(self.role_min_name(i), name, previous, name, previous))
+        lines.append("{} = {}".format(self.first_role_name(), self.role_min_name(len(names) - 1)))
+        return lines
+
+    def role_index_array_line(self, position, op_item):
+        ''' Generate the string for a single element of the role index array '''
+        return "[{} - {}] = {}".format(op_item.attrib['name'], self.first_role_name(), position + 1)
+
     @staticmethod
     def opmsgs_array_line(op_id_dict):
         ''' Generate the string for a single element of a opmsgs array '''
@@ -173,6 +214,19 @@ class ChainConfigurationGenerator(ChainGenerator):
                 with Array("static const operator_config_t", "operators") as array:
                     array.extend([self.operators_array_line(operator) for operator in self.operators])  # pylint: disable=no-member
 
+                self.check_operator_roles()
+
+                with Enumeration("{}_role_range".format(self.chain_name)) as enum:
+                    enum.extend(self.role_index_enum_lines())  # pylint: disable=no-member
+
+                with Array("static const uint8", "operator_index_by_role") as array:
+                    array.extend([self.role_index_array_line(position, operator)  # pylint: disable=no-member
+                                  for position, operator in enumerate(self.operators)])
+
+                print("static const operator_role_index_t operator_role_index = "
+                      "{{{}, ARRAY_DIM(operator_index_by_role), operator_index_by_role}};\n".format(self.first_role_name()),
+                      file=self.outfile)
+
             if self.inputs:
                 with Array("static const operator_endpoint_t", "inputs") as array:
                     array.extend([self.inputs_array_line(inp) for inp in self.inputs])
@@ -207,7 +261,7 @@ class ChainConfigurationGenerator(ChainGenerator):
                     with Array("const chain_operator_message_t", self.opmsgs_config_name(config_name)) as array:
                         array.extend([self.opmsgs_array_line(opmsg) for opmsg in opmsgs])
 
-            config_str = "const chain_config_t {}_config = {{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}}};\n"
+            config_str = "const chain_config_t {}_config = {{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}, NULL, 0, {}}};\n"
             print(config_str.format(self.chain_name,
                                     self.chain_id,
                                     self.chain_ucid,
@@ -218,7 +272,8 @@ class ChainConfigurationGenerator(ChainGenerator):
                                     'outputs' if self.outputs else 'NULL',
                                     len(self.outputs),
                                     'connections' if self.connections else 'NULL',
-                                    len(self.connections)), file=self.outfile)
+                                    len(self.connections),
+                                    '&operator_role_index' if self.operators else 'NULL'), file=self.outfile)
         else:
             # Generate the C chain declarations for the .h file
             print("#include <chain.h>\n", file=self.outfile)
@@ -281,7 +336,7 @@ def create_header(element_tree_root, file_handle):
     with HeaderGuards(doxygen.chain_name, file_handle):
         try:
             ChainConfigurationGenerator(element_tree_root, file_handle).generate(False)
-        except ChainTerminalException as err:
+        except (ChainTerminalException, ChainOperatorException) as err:
             print(err, file=sys.stderr)
             exit(2)
 
@@ -302,7 +357,7 @@ def create_source(element_tree_root, file_handle):
     DoxygenGenerator(element_tree_root, file_handle).generate('c')
     try:
         ChainConfigurationGenerator(element_tree_root, file_handle).generate()
-    except ChainTerminalException as err:
+    except (ChainTerminalException, ChainOperatorException) as err:
         print(err, file=sys.stderr)
         exit(2)
 
@@ -329,7 +384,7 @@ def _create_folders(folder):
 def create_uml(element_tree_root, file_handle):
     try:
         ChainPlantUmlDiagramGenerator(element_tree_root, file_handle).generate()
-    except ChainTerminalException as err:
+    except (ChainTerminalException, ChainOperatorException) as err:
         print(err, file=sys.stderr)
         exit(2)
 
@@ -0,0 +1,156 @@
+'''
+ Copyright (c) 2019 Qualcomm Technologies International, Ltd.
+
+ Regression tests for the operator role index that chaingen writes into the
+ generated chain source. chaingen is run the way Makefile.rules runs it, with
+ the source printed to stdout.
+
+ Run with: python test_chaingen.py
+'''
+
+from __future__ import print_function
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+
+ME = os.path.abspath(__file__)
+MEDIR = os.path.dirname(ME)
+CHAINGEN = os.path.join(MEDIR, 'chaingen.py')
+
+# Operator roles as the including application might number them: not
+# starting at zero, not in the order the operators are listed and with gaps.
+ROLES = {
+    'OPR_TEST_DECODER': 0x1005,
+    'OPR_TEST_MIXER': 0x1002,
+    'OPR_TEST_RESAMPLER': 0x1009,
+}
+
+CHAIN = '''<?xml version="1.0" encoding="UTF-8"?>
+<chain name="CHAIN_TEST" id="0" generate_operator_roles_enum="False" generate_endpoint_roles_enum="False">
+    <include_header name="test_chain_roles.h"/>
+    <operator name="OPR_TEST_DECODER" id="CAP_ID_SBC_DECODER">
+        <sink name="IN" terminal="0"/>
+        <source name="OUT" terminal="0"/>
+    </operator>
+    <operator name="OPR_TEST_MIXER" id="CAP_ID_MIXER">
+        <sink name="IN" terminal="0"/>
+        <source name="OUT" terminal="0"/>
+    </operator>
+    <operator name="{third}" id="CAP_ID_IIR_RESAMPLER">
+        <sink name="IN" terminal="0"/>
+        <source name="OUT" terminal="0"/>
+    </operator>
+    <connection source="OPR_TEST_DECODER.OUT" sink="OPR_TEST_MIXER.IN"/>
+    <input sink="OPR_TEST_DECODER.IN" role="EPR_TEST_IN"/>
+    <output source="OPR_TEST_MIXER.OUT" role="EPR_TEST_OUT"/>
+</chain>
+'''
+
+ENUM_LINES = [
+    'chain_test_role_min_0 = OPR_TEST_DECODER,',
+    'chain_test_role_min_1 = (OPR_TEST_MIXER < chain_test_role_min_0) ? OPR_TEST_MIXER : chain_test_role_min_0,',
+    'chain_test_role_min_2 = (OPR_TEST_RESAMPLER < chain_test_role_min_1) ? OPR_TEST_RESAMPLER : chain_test_role_min_1,',
+    'chain_test_first_role = chain_test_role_min_2,',
+]
+
+INDEX_LINES = [
+    '[OPR_TEST_DECODER - chain_test_first_role] = 1,',
+    '[OPR_TEST_MIXER - chain_test_first_role] = 2,',
+    '[OPR_TEST_RESAMPLER - chain_test_first_role] = 3,',
+]
+
+MIN_EXPR = re.compile(r'^\((\w+) < (\w+)\) \? (\w+) : (\w+)$')
+INDEX_ELEMENT = re.compile(r'^\[(\w+) - (\w+)\] = (\d+)$')
+
+
+def block_lines(source, opening):
+    ''' The lines between an opening line and the closing brace that follows it '''
+    lines = [line.strip() for line in source.splitlines()]
+    start = lines.index(opening) + 2
+    end = lines.index('} ;', start)
+    return lines[start:end]
+
+
+def evaluate_enum(lines, values):
+    ''' Work out the enumerators the way the compiler would '''
+    values = dict(values)
+    for line in lines:
+        name, expr = [part.strip() for part in line.rstrip(',').split('=', 1)]
+        match = MIN_EXPR.match(expr)
+        if match:
+            left, right, if_less, otherwise = match.groups()
+            values[name] = values[if_less] if values[left] < values[right] else values[otherwise]
+        else:
+            values[name] = values[expr]
+    return values
+
+
+def evaluate_index(lines, values):
+    ''' Build the role index array from its designated initialisers '''
+    elements = {}
+    for line in lines:
+        role, base, position = INDEX_ELEMENT.match(line.rstrip(',')).groups()
+        elements[values[role] - values[base]] = int(position)
+    return [elements.get(i, 0) for i in range(max(elements) + 1)]
+
+
+class RoleIndexTest(unittest.TestCase):
+    ''' Generate a chain and check its operator role index '''
+
+    def setUp(self):
+        self.folder = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.folder)
+
+    def write_chain(self, third_operator):
+        ''' Write the test chain and return its file name '''
+        filename = os.path.join(self.folder, 'chain_test.chain')
+        with open(filename, 'w') as chain:
+            chain.write(CHAIN.format(third=third_operator))
+        return filename
+
+    def run_chaingen(self, filename):
+        ''' Run chaingen --source on a chain file, returning its exit code,
+            stdout and stderr '''
+        process = subprocess.Popen([sys.executable, CHAINGEN, os.path.basename(filename), '--source'],
+                                   cwd=self.folder, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                                   universal_newlines=True)
+        out, err = process.communicate()
+        return process.returncode, out, err
+
+    def test_role_index(self):
+        returncode, source, err = self.run_chaingen(self.write_chain('OPR_TEST_RESAMPLER'))
+        self.assertEqual(0, returncode, err)
+
+        enum_lines = block_lines(source, 'enum chain_test_role_range')
+        index_lines = block_lines(source, 'static const uint8 operator_index_by_role[] =')
+        self.assertEqual(ENUM_LINES, enum_lines)
+        self.assertEqual(INDEX_LINES, index_lines)
+        self.assertIn('static const operator_role_index_t operator_role_index = '
+                      '{chain_test_first_role, ARRAY_DIM(operator_index_by_role), operator_index_by_role};',
+                      source)
+        self.assertIn('const chain_config_t chain_test_config = '
+                      '{0, 0, operators, 3, inputs, 1, outputs, 1, connections, 1, NULL, 0, &operator_role_index};',
+                      source)
+
+        # With the roles numbered, each role maps to its operator's position
+        # plus one and the roles in between map to zero
+        values = evaluate_enum(enum_lines, ROLES)
+        self.assertEqual(0x1002, values['chain_test_first_role'])
+        index = evaluate_index(index_lines, values)
+        self.assertEqual([2, 0, 0, 1, 0, 0, 0, 3], index)
+
+    def test_duplicate_role_rejected(self):
+        returncode, source, err = self.run_chaingen(self.write_chain('OPR_TEST_DECODER'))
+        self.assertEqual(2, returncode)
+        self.assertIn('OPR_TEST_DECODER', err)
+        self.assertNotIn('operator_index_by_role', source)
+
+
+if __name__ == '__main__':
+    unittest.main()
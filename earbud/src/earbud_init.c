@@ -428,6 +428,7 @@ static const init_table_entry_t appInitTable[] =
     {appBatteryInit,        MESSAGE_BATTERY_INIT_CFM, NULL},
 #ifdef INCLUDE_CHARGER
     {appChargerInit,        0, NULL},
+    {appBatteryRegisterChargerClient, 0, NULL},
 #endif
     {appLedInit,            0, NULL},
     {appPowerInit,          APP_POWER_INIT_CFM, NULL},